@@ -6,6 +6,7 @@
 #ifndef JLM_JLMOPT_CMDLINE_HPP
 #define JLM_JLMOPT_CMDLINE_HPP
 
+#include <jlm/backend/llvm/rvsdg2jlm/schedule.hpp>
 #include <jlm/util/file.hpp>
 #include <jlm/util/stats.hpp>
 
@@ -24,11 +25,15 @@ public:
 	: ifile("")
 	, ofile("")
 	, format(outputformat::llvm)
+	, schedule(rvsdg2jlm::schedulingmode::topdown)
+	, streaming(false)
 	{}
 
 	jlm::filepath ifile;
 	jlm::filepath ofile;
 	outputformat format;
+	rvsdg2jlm::schedulingmode schedule;
+	bool streaming;
 	stats_descriptor sd;
 	std::vector<jlm::optimization*> optimizations;
 };
@@ -14,13 +14,27 @@
 #include <jlm/opt/inversion.hpp>
 #include <jlm/opt/unroll.hpp>
 #include <jlm/opt/reduction.hpp>
+#include <jlm/opt/sccp.hpp>
+#include <jlm/opt/dae.hpp>
+#include <jlm/opt/specialization.hpp>
+#include <jlm/opt/devirtualization.hpp>
+#include <jlm/opt/ifconversion.hpp>
+#include <jlm/opt/gammafusion.hpp>
+#include <jlm/opt/unswitching.hpp>
+#include <jlm/opt/thetafusion.hpp>
+#include <jlm/opt/sroa.hpp>
+#include <jlm/opt/heap2stack.hpp>
+#include <jlm/opt/memcpyexpansion.hpp>
+#include <jlm/opt/globalfolding.hpp>
+#include <jlm/opt/functionmerging.hpp>
 #include <jlm/opt/optimization.hpp>
 
 #include <llvm/Support/CommandLine.h>
+#include <llvm/Support/raw_ostream.h>
 
 namespace jlm {
 
-enum class optimizationid {cne, dne, iln, inv, psh, red, ivt, url, pll};
+enum class optimizationid {cne, dne, iln, inv, psh, red, ivt, url, pll, scp, dae, spc, dvt, ifc, gfs, usw, tfs, sra, h2s, mcp, glf, fmg, rsw};
 
 static jlm::optimization *
 mapoptid(enum optimizationid id)
@@ -34,6 +48,20 @@ mapoptid(enum optimizationid id)
 	static jlm::tginversion tginversion;
 	static jlm::loopunroll loopunroll(4);
 	static jlm::nodereduction nodereduction;
+	static jlm::nodereduction nodereduction_sweep(true);
+	static jlm::sccp sccp;
+	static jlm::dae dae;
+	static jlm::fctspecialization fctspecialization(1000);
+	static jlm::devirtualization devirtualization(4);
+	static jlm::ifconversion ifconversion(8);
+	static jlm::gammafusion gammafusion;
+	static jlm::loopunswitching loopunswitching(100);
+	static jlm::thetafusion thetafusion;
+	static jlm::sroa sroa;
+	static jlm::heap2stack heap2stack(1024);
+	static jlm::memcpyexpansion memcpyexpansion(64);
+	static jlm::globalfolding globalfolding;
+	static jlm::functionmerging functionmerging;
 
 	static std::unordered_map<optimizationid, jlm::optimization*>
 	map({
@@ -46,6 +74,20 @@ mapoptid(enum optimizationid id)
 	, {optimizationid::ivt, &tginversion}
 	, {optimizationid::url, &loopunroll}
 	, {optimizationid::red, &nodereduction}
+	, {optimizationid::scp, &sccp}
+	, {optimizationid::dae, &dae}
+	, {optimizationid::spc, &fctspecialization}
+	, {optimizationid::dvt, &devirtualization}
+	, {optimizationid::ifc, &ifconversion}
+	, {optimizationid::gfs, &gammafusion}
+	, {optimizationid::usw, &loopunswitching}
+	, {optimizationid::tfs, &thetafusion}
+	, {optimizationid::sra, &sroa}
+	, {optimizationid::h2s, &heap2stack}
+	, {optimizationid::mcp, &memcpyexpansion}
+	, {optimizationid::glf, &globalfolding}
+	, {optimizationid::fmg, &functionmerging}
+	, {optimizationid::rsw, &nodereduction_sweep}
 	});
 
 	JLM_ASSERT(map.find(id) != map.end());
@@ -121,6 +163,16 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 	, cl::ValueDisallowed
 	, cl::desc("Write RVSDG optimization stats to file."));
 
+	cl::opt<bool> print_dae_stat(
+	  "print-dae-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write dead argument elimination statistics to file."));
+
+	cl::opt<bool> print_devirtualization_stat(
+	  "print-devirtualization-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write indirect call promotion statistics to file."));
+
 	cl::opt<bool> print_dne_stat(
 	  "print-dne-stat"
 	, cl::ValueDisallowed
@@ -131,6 +183,31 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 	, cl::ValueDisallowed
 	, cl::desc("Write common node elimination statistics to file."));
 
+	cl::opt<bool> print_functionmerging_stat(
+	  "print-functionmerging-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write function merging statistics to file."));
+
+	cl::opt<bool> print_gammafusion_stat(
+	  "print-gammafusion-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write gamma fusion statistics to file."));
+
+	cl::opt<bool> print_globalfolding_stat(
+	  "print-globalfolding-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write constant global folding statistics to file."));
+
+	cl::opt<bool> print_heap2stack_stat(
+	  "print-heap2stack-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write heap-to-stack promotion statistics to file."));
+
+	cl::opt<bool> print_ifconversion_stat(
+	  "print-ifconversion-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write if-conversion statistics to file."));
+
 	cl::opt<bool> print_iln_stat(
 	  "print-iln-stat"
 	, cl::ValueDisallowed
@@ -146,6 +223,11 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 	, cl::ValueDisallowed
 	, cl::desc("Write theta-gamma inversion statistics to file."));
 
+	cl::opt<bool> print_memcpyexpansion_stat(
+	  "print-memcpyexpansion-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write memcpy expansion statistics to file."));
+
 	cl::opt<bool> print_pull_stat(
 	  "print-pull-stat"
 	, cl::ValueDisallowed
@@ -161,17 +243,57 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 	, cl::ValueDisallowed
 	, cl::desc("Write reduction statistics to file."));
 
+	cl::opt<bool> print_sccp_stat(
+	  "print-sccp-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write sparse conditional constant propagation statistics to file."));
+
+	cl::opt<bool> print_specialization_stat(
+	  "print-specialization-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write function specialization statistics to file."));
+
+	cl::opt<bool> print_sroa_stat(
+	  "print-sroa-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write scalar replacement of aggregates statistics to file."));
+
+	cl::opt<bool> print_thetafusion_stat(
+	  "print-thetafusion-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write theta fusion statistics to file."));
+
 	cl::opt<bool> print_unroll_stat(
 	  "print-unroll-stat"
 	, cl::ValueDisallowed
 	, cl::desc("Write loop unrolling statistics to file."));
 
+	cl::opt<bool> print_unswitching_stat(
+	  "print-unswitching-stat"
+	, cl::ValueDisallowed
+	, cl::desc("Write loop unswitching statistics to file."));
+
+	cl::opt<bool> streaming(
+	  "streaming"
+	, cl::ValueDisallowed
+	, cl::desc("Compile the module one call graph SCC at a time to bound memory usage. "
+		"Interprocedural optimizations only see a single SCC, such that scp, dae, spc, and fmg "
+		"have no effect across SCCs. Requires LLVM output."));
+
 	cl::opt<outputformat> format(
 	  cl::values(
 		  clEnumValN(outputformat::llvm, "llvm", "Output LLVM IR [default]")
 		, clEnumValN(outputformat::xml, "xml", "Output XML"))
 	, cl::desc("Select output format"));
 
+	cl::opt<jlm::rvsdg2jlm::schedulingmode> schedule(
+	  "schedule"
+	, cl::values(
+		  clEnumValN(jlm::rvsdg2jlm::schedulingmode::topdown, "topdown", "Top-down order [default]")
+		, clEnumValN(jlm::rvsdg2jlm::schedulingmode::pressure, "pressure", "Minimize register pressure")
+		, clEnumValN(jlm::rvsdg2jlm::schedulingmode::latency, "latency", "Hide operation latencies"))
+	, cl::desc("Select node scheduling for RVSDG destruction"));
+
 	cl::list<jlm::optimizationid> optids(
 		cl::values(
 		  clEnumValN(jlm::optimizationid::cne, "cne", "Common node elimination")
@@ -182,7 +304,21 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 		, clEnumValN(jlm::optimizationid::pll, "pll", "Node pull in")
 		, clEnumValN(jlm::optimizationid::red, "red", "Node reductions")
 		, clEnumValN(jlm::optimizationid::ivt, "ivt", "Theta-gamma inversion")
-		, clEnumValN(jlm::optimizationid::url, "url", "Loop unrolling"))
+		, clEnumValN(jlm::optimizationid::url, "url", "Loop unrolling")
+		, clEnumValN(jlm::optimizationid::scp, "scp", "Sparse conditional constant propagation")
+		, clEnumValN(jlm::optimizationid::dae, "dae", "Dead argument elimination")
+		, clEnumValN(jlm::optimizationid::spc, "spc", "Function specialization")
+		, clEnumValN(jlm::optimizationid::dvt, "dvt", "Indirect call promotion")
+		, clEnumValN(jlm::optimizationid::ifc, "ifc", "If-conversion")
+		, clEnumValN(jlm::optimizationid::gfs, "gfs", "Gamma fusion")
+		, clEnumValN(jlm::optimizationid::usw, "usw", "Loop unswitching")
+		, clEnumValN(jlm::optimizationid::tfs, "tfs", "Theta fusion")
+		, clEnumValN(jlm::optimizationid::sra, "sra", "Scalar replacement of aggregates")
+		, clEnumValN(jlm::optimizationid::h2s, "h2s", "Heap-to-stack promotion")
+		, clEnumValN(jlm::optimizationid::mcp, "mcp", "Memcpy expansion")
+		, clEnumValN(jlm::optimizationid::glf, "glf", "Constant global folding")
+		, clEnumValN(jlm::optimizationid::fmg, "fmg", "Function merging")
+		, clEnumValN(jlm::optimizationid::rsw, "rsw", "Node reductions over the entire graph"))
 	, cl::desc("Perform optimization"));
 
 	cl::ParseCommandLineOptions(argc, argv);
@@ -192,6 +328,11 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 		exit(EXIT_SUCCESS);
 	}
 
+	if (streaming && format != outputformat::llvm) {
+		llvm::errs() << argv[0] << ": --streaming requires LLVM output.\n";
+		exit(EXIT_FAILURE);
+	}
+
 	if (!ofile.empty())
 		options.ofile = ofile;
 
@@ -204,17 +345,32 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 
 	options.ifile = ifile;
 	options.format = format;
+	options.schedule = schedule;
+	options.streaming = streaming;
 	options.optimizations = optimizations;
 	options.sd.print_cfr_time = print_cfr_time;
 	options.sd.print_cne_stat = print_cne_stat;
+	options.sd.print_dae_stat = print_dae_stat;
+	options.sd.print_devirtualization_stat = print_devirtualization_stat;
 	options.sd.print_dne_stat = print_dne_stat;
+	options.sd.print_functionmerging_stat = print_functionmerging_stat;
+	options.sd.print_gammafusion_stat = print_gammafusion_stat;
+	options.sd.print_globalfolding_stat = print_globalfolding_stat;
+	options.sd.print_heap2stack_stat = print_heap2stack_stat;
+	options.sd.print_ifconversion_stat = print_ifconversion_stat;
 	options.sd.print_iln_stat = print_iln_stat;
 	options.sd.print_inv_stat = print_inv_stat;
 	options.sd.print_ivt_stat = print_ivt_stat;
+	options.sd.print_memcpyexpansion_stat = print_memcpyexpansion_stat;
 	options.sd.print_pull_stat = print_pull_stat;
 	options.sd.print_push_stat = print_push_stat;
 	options.sd.print_reduction_stat = print_reduction_stat;
+	options.sd.print_sccp_stat = print_sccp_stat;
+	options.sd.print_specialization_stat = print_specialization_stat;
+	options.sd.print_sroa_stat = print_sroa_stat;
+	options.sd.print_thetafusion_stat = print_thetafusion_stat;
 	options.sd.print_unroll_stat = print_unroll_stat;
+	options.sd.print_unswitching_stat = print_unswitching_stat;
 	options.sd.print_annotation_time = print_annotation_time;
 	options.sd.print_aggregation_time = print_aggregation_time;
 	options.sd.print_rvsdg_construction = print_rvsdg_construction;
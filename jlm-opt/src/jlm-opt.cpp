@@ -9,6 +9,7 @@
 #include <jlm/backend/llvm/rvsdg2jlm/rvsdg2jlm.hpp>
 #include <jlm/frontend/llvm/jlm2rvsdg/module.hpp>
 #include <jlm/frontend/llvm/llvm2jlm/module.hpp>
+#include <jlm/ir/ipgraph.hpp>
 #include <jlm/ir/ipgraph-module.hpp>
 #include <jlm/ir/operators.hpp>
 #include <jlm/ir/rvsdg-module.hpp>
@@ -31,7 +32,7 @@ parse_llvm_file(
 	llvm::LLVMContext & ctx)
 {
 	llvm::SMDiagnostic d;
-	auto module = llvm::parseIRFile(file.to_str(), d, ctx);
+	auto module = llvm::getLazyIRFileModule(file.to_str(), d, ctx);
 	if (!module) {
 		d.print(executable, llvm::errs());
 		exit(EXIT_FAILURE);
@@ -40,16 +41,36 @@ parse_llvm_file(
 	return module;
 }
 
-static std::unique_ptr<jlm::ipgraph_module>
-construct_jlm_module(llvm::Module & module)
+/*
+	The dependencies of the functions are collected from a second lazily loaded copy of the input,
+	which is discarded right after. Parsing the bodies twice permits to keep only a single LLVM
+	body in memory at any time.
+*/
+static std::unique_ptr<jlm::lazy_module_converter>
+create_converter(const char * executable, const jlm::filepath & file, llvm::Module & module)
+{
+	llvm::LLVMContext ctx;
+	auto scan = parse_llvm_file(executable, file, ctx);
+	return std::make_unique<jlm::lazy_module_converter>(module, *scan);
+}
+
+/*
+	Function bodies are only converted to CFGs when the RVSDG construction reaches their SCC, and
+	both the LLVM body and the CFG are freed as soon as the lambdas of the SCC are built.
+*/
+static std::unique_ptr<jlm::rvsdg_module>
+construct_rvsdg(jlm::lazy_module_converter & converter, const jlm::stats_descriptor & sd)
 {
-	return jlm::convert_module(module);
+	return jlm::construct_rvsdg(converter.module(), sd,
+		[&](jlm::function_node & f){ converter.materialize(f); },
+		[&](jlm::function_node & f){ converter.release(f); });
 }
 
 static void
 print_as_xml(
 	const jlm::rvsdg_module & rm,
 	const jlm::filepath & fp,
+	const jlm::rvsdg2jlm::schedulingmode&,
 	const jlm::stats_descriptor&)
 {
 	auto fd = fp == "" ? stdout : fopen(fp.to_str().c_str(), "w");
@@ -60,25 +81,32 @@ print_as_xml(
 			fclose(fd);
 }
 
+static void
+print_llvm_module(const llvm::Module & module, const jlm::filepath & fp)
+{
+	if (fp == "") {
+		llvm::raw_os_ostream os(std::cout);
+		module.print(os, nullptr);
+	} else {
+		std::error_code ec;
+		llvm::raw_fd_ostream os(fp.to_str(), ec);
+		module.print(os, nullptr);
+	}
+}
+
 static void
 print_as_llvm(
 	const jlm::rvsdg_module & rm,
 	const jlm::filepath & fp,
+	const jlm::rvsdg2jlm::schedulingmode & schedule,
 	const jlm::stats_descriptor & sd)
 {
-	auto jlm_module = jlm::rvsdg2jlm::rvsdg2jlm(rm, sd);
+	auto jlm_module = jlm::rvsdg2jlm::rvsdg2jlm(rm, sd, schedule);
 
 	llvm::LLVMContext ctx;
 	auto llvm_module = jlm::jlm2llvm::convert(*jlm_module, ctx);
 
-	if (fp == "") {
-		llvm::raw_os_ostream os(std::cout);
-		llvm_module->print(os, nullptr);
-	} else {
-		std::error_code ec;
-		llvm::raw_fd_ostream os(fp.to_str(), ec);
-		llvm_module->print(os, nullptr);
-	}
+	print_llvm_module(*llvm_module, fp);
 }
 
 static void
@@ -86,20 +114,66 @@ print(
 	const jlm::rvsdg_module & rm,
 	const jlm::filepath & fp,
 	const jlm::outputformat & format,
+	const jlm::rvsdg2jlm::schedulingmode & schedule,
 	const jlm::stats_descriptor & sd)
 {
 	using namespace jlm;
 
 	static std::unordered_map<
 		jlm::outputformat,
-		std::function<void(const rvsdg_module&, const filepath&, const stats_descriptor&)>
+		std::function<void(const rvsdg_module&, const filepath&, const rvsdg2jlm::schedulingmode&,
+			const stats_descriptor&)>
 	> formatters({
 		{outputformat::xml,  print_as_xml}
 	, {outputformat::llvm, print_as_llvm}
 	});
 
 	JLM_ASSERT(formatters.find(format) != formatters.end());
-	formatters[format](rm, fp, sd);
+	formatters[format](rm, fp, schedule, sd);
+}
+
+/*
+	Compiles the module one ipgraph SCC at a time. Every SCC is converted to its own RVSDG module,
+	optimized, and converted back to LLVM, before it is linked to the output module and its RVSDG
+	as well as its CFGs are discarded. Only the RVSDG and the CFGs of a single SCC are therefore
+	alive at any time. The input module, the ipgraph, and the linked output module still grow with
+	the entire module.
+*/
+static void
+compile_streaming(jlm::lazy_module_converter & converter, const jlm::cmdline_options & flags)
+{
+	auto & im = converter.module();
+
+	llvm::LLVMContext ctx;
+	auto output = std::make_unique<llvm::Module>(im.source_filename().to_str(), ctx);
+	output->setTargetTriple(im.target_triple());
+	output->setDataLayout(im.data_layout());
+
+	for (const auto & scc : im.ipgraph().find_sccs()) {
+		std::vector<jlm::function_node*> functions;
+		for (const auto & node : scc) {
+			if (auto function = dynamic_cast<jlm::function_node*>(node))
+				functions.push_back(function);
+		}
+
+		for (const auto & function : functions)
+			converter.materialize(*function);
+
+		std::unordered_set<const jlm::ipgraph_node*> nodes(scc.begin(), scc.end());
+		auto rm = jlm::construct_rvsdg(im, nodes, flags.sd);
+
+		for (const auto & function : functions)
+			converter.release(*function);
+
+		optimize(*rm, flags.sd, flags.optimizations);
+
+		auto jm = jlm::rvsdg2jlm::rvsdg2jlm(*rm, flags.sd, flags.schedule);
+		rm.reset();
+
+		jlm::jlm2llvm::link(*output, jlm::jlm2llvm::convert(*jm, ctx));
+	}
+
+	print_llvm_module(*output, flags.ofile);
 }
 
 int
@@ -110,15 +184,20 @@ main(int argc, char ** argv)
 
 	llvm::LLVMContext ctx;
 	auto llvm_module = parse_llvm_file(argv[0], flags.ifile, ctx);
+	auto converter = create_converter(argv[0], flags.ifile, *llvm_module);
 
-	auto jlm_module = construct_jlm_module(*llvm_module);
+	if (flags.streaming) {
+		compile_streaming(*converter, flags);
+		return 0;
+	}
 
+	auto rm = construct_rvsdg(*converter, flags.sd);
+	converter.reset();
 	llvm_module.reset();
-	auto rm = jlm::construct_rvsdg(*jlm_module, flags.sd);
 
 	optimize(*rm, flags.sd, flags.optimizations);
 
-	print(*rm, flags.ofile, flags.format, flags.sd);
+	print(*rm, flags.ofile, flags.format, flags.schedule, flags.sd);
 
 	return 0;
 }
@@ -28,6 +28,16 @@ namespace jlm2llvm {
 std::unique_ptr<llvm::Module>
 convert(ipgraph_module & im, llvm::LLVMContext & ctx);
 
+/**
+* Links \p src into \p dst. The declarations of \p src are resolved to the definitions of
+* \p dst, including definitions with local linkage, which keep their linkage. This permits to
+* convert the SCCs of a module one at a time, as the module of an SCC declares the nodes of
+* previous SCCs with external linkage.
+* Throws a jlm::error if the linking fails.
+*/
+void
+link(llvm::Module & dst, std::unique_ptr<llvm::Module> src);
+
 }}
 
 #endif
@@ -6,21 +6,31 @@
 #ifndef JLM_BACKEND_LLVM_RVSDG2JLM_CONTEXT_HPP
 #define JLM_BACKEND_LLVM_RVSDG2JLM_CONTEXT_HPP
 
+#include <jlm/backend/llvm/rvsdg2jlm/schedule.hpp>
+
+#include <unordered_map>
+
 namespace jlm {
 
 class cfg_node;
+class function_node;
 class ipgraph_module;
 class variable;
 
+namespace lambda {
+	class node;
+}
+
 namespace rvsdg2jlm {
 
 class context final {
 public:
 	inline
-	context(ipgraph_module & im)
+	context(ipgraph_module & im, schedulingmode mode)
 	: cfg_(nullptr)
 	, module_(im)
 	, lpbb_(nullptr)
+	, mode_(mode)
 	{}
 
 	context(const context&) = delete;
@@ -47,6 +57,12 @@ public:
 		ports_[port] = v;
 	}
 
+	inline bool
+	contains(const jive::output * port) const noexcept
+	{
+		return ports_.find(port) != ports_.end();
+	}
+
 	inline const jlm::variable *
 	variable(const jive::output * port)
 	{
@@ -79,11 +95,62 @@ public:
 		cfg_ = cfg;
 	}
 
+	inline schedulingmode
+	mode() const noexcept
+	{
+		return mode_;
+	}
+
+	/**
+	* Defers the CFG construction of \p lambda, the body of \p function, until all other nodes
+	* are converted.
+	*/
+	inline void
+	defer(const lambda::node & lambda, function_node * function)
+	{
+		deferred_.push_back({&lambda, function});
+	}
+
+	inline const std::vector<std::pair<const lambda::node*, function_node*>> &
+	deferred() const noexcept
+	{
+		return deferred_;
+	}
+
+	/**
+	* Computes the schedule of \p region ahead of its conversion. Computing a schedule traverses
+	* the RVSDG, which is not thread-safe, while a precomputed schedule is only read.
+	*/
+	inline void
+	precompute_schedule(jive::region & region)
+	{
+		schedules_[&region] = rvsdg2jlm::schedule(region, mode_, latencies_);
+	}
+
+	/**
+	* Returns the schedule of \p region. A precomputed schedule is handed out only once.
+	*/
+	inline std::vector<jive::node*>
+	schedule(jive::region & region)
+	{
+		auto it = schedules_.find(&region);
+		if (it == schedules_.end())
+			return rvsdg2jlm::schedule(region, mode_, latencies_);
+
+		auto nodes = std::move(it->second);
+		schedules_.erase(it);
+		return nodes;
+	}
+
 private:
 	jlm::cfg * cfg_;
 	ipgraph_module & module_;
 	basic_block * lpbb_;
+	schedulingmode mode_;
+	latencymap latencies_;
 	std::unordered_map<const jive::output*, const jlm::variable*> ports_;
+	std::unordered_map<const jive::region*, std::vector<jive::node*>> schedules_;
+	std::vector<std::pair<const lambda::node*, function_node*>> deferred_;
 };
 
 }}
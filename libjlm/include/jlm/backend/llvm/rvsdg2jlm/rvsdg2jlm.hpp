@@ -6,6 +6,8 @@
 #ifndef JLM_BACKEND_LLVM_RVSDG2JLM_RVSDG2JLM_HPP
 #define JLM_BACKEND_LLVM_RVSDG2JLM_RVSDG2JLM_HPP
 
+#include <jlm/backend/llvm/rvsdg2jlm/schedule.hpp>
+
 #include <memory>
 
 namespace jive {
@@ -23,7 +25,10 @@ class stats_descriptor;
 namespace rvsdg2jlm {
 
 std::unique_ptr<ipgraph_module>
-rvsdg2jlm(const rvsdg_module & rm, const stats_descriptor & sd);
+rvsdg2jlm(
+	const rvsdg_module & rm,
+	const stats_descriptor & sd,
+	schedulingmode mode = schedulingmode::topdown);
 
 }}
 
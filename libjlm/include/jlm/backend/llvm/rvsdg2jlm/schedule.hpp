@@ -0,0 +1,76 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_BACKEND_LLVM_RVSDG2JLM_SCHEDULE_HPP
+#define JLM_BACKEND_LLVM_RVSDG2JLM_SCHEDULE_HPP
+
+#include <unordered_map>
+#include <vector>
+
+namespace jive {
+	class node;
+	class region;
+}
+
+namespace jlm {
+namespace rvsdg2jlm {
+
+/**
+* The strategies for linearizing the nodes of a region during RVSDG destruction.
+*/
+enum class schedulingmode {
+  topdown  /**< Nodes are ordered as produced by the top-down traverser. */
+, pressure /**< Nodes are placed right before their first use, larger subtrees first. */
+, latency  /**< Nodes on the longest latency path to the region's results are placed first. */
+};
+
+/**
+* Memoizes the latency estimates of nodes. The estimate of a structural node depends on the
+* nodes of all its nested regions. A map that is shared between the schedules of nested
+* regions ensures that every node is only estimated once.
+*/
+class latencymap final {
+public:
+	/**
+	* Returns a rough estimate of the number of cycles it takes until the results of \p node
+	* are available.
+	*/
+	size_t
+	latency(const jive::node & node);
+
+private:
+	std::unordered_map<const jive::node*, size_t> latencies_;
+};
+
+/**
+* Computes an order of all nodes in \p region in which each node succeeds the producers of its
+* operands.
+*
+* The \ref schedulingmode::pressure mode is a Sethi-Ullman style scheduler. It emits the
+* nodes in a depth-first traversal from the region's results, and visits the operands with the
+* highest register need first. This keeps values close to their uses and reduces the number
+* of simultaneously live values.
+*
+* The \ref schedulingmode::latency mode is a list scheduler. It prioritizes nodes by their
+* estimated latency distance to the region's results, such that long latency operations, e.g.,
+* loads and calls, are started as early as possible.
+*
+* \param region The region that is scheduled.
+* \param mode The scheduling strategy.
+*
+* \return The scheduled nodes of \p region.
+*/
+std::vector<jive::node*>
+schedule(jive::region & region, schedulingmode mode);
+
+/**
+* Computes a schedule of \p region as above, but retrieves latency estimates from \p latencies.
+*/
+std::vector<jive::node*>
+schedule(jive::region & region, schedulingmode mode, latencymap & latencies);
+
+}}
+
+#endif
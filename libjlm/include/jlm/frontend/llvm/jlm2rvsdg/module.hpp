@@ -6,7 +6,9 @@
 #ifndef JLM_FRONTEND_LLVM_JLM2RVSDG_MODULE_H
 #define JLM_FRONTEND_LLVM_JLM2RVSDG_MODULE_H
 
+#include <functional>
 #include <memory>
+#include <unordered_set>
 
 namespace jive {
 	class graph;
@@ -14,13 +16,40 @@ namespace jive {
 
 namespace jlm {
 
+class function_node;
 class ipgraph_module;
+class ipgraph_node;
 class rvsdg_module;
 class stats_descriptor;
 
 std::unique_ptr<rvsdg_module>
 construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd);
 
+/**
+* Constructs the RVSDG one ipgraph SCC at a time. The CFGs of the function nodes of an SCC are
+* requested with \p materialize right before the SCC is converted, and are handed back with
+* \p release as soon as its lambdas are constructed. The dependencies of all ipgraph nodes must
+* already be present in \p im, as they determine the SCCs.
+*/
+std::unique_ptr<rvsdg_module>
+construct_rvsdg(
+	ipgraph_module & im,
+	const stats_descriptor & sd,
+	const std::function<void(function_node&)> & materialize,
+	const std::function<void(function_node&)> & release);
+
+/**
+* Constructs an RVSDG module that only contains the ipgraph nodes of \p scc. The nodes of other
+* SCCs that \p scc depends on are imported with external linkage, and all nodes of \p scc are
+* exported regardless of their linkage, such that the module can be optimized and emitted on its
+* own and afterwards be linked with the modules of the other SCCs.
+*/
+std::unique_ptr<rvsdg_module>
+construct_rvsdg(
+	const ipgraph_module & im,
+	const std::unordered_set<const ipgraph_node*> & scc,
+	const stats_descriptor & sd);
+
 }
 
 #endif
@@ -14,6 +14,7 @@
 #include <jive/types/record.hpp>
 #include <llvm/IR/DerivedTypes.h>
 
+#include <mutex>
 #include <unordered_map>
 
 namespace llvm {
@@ -89,12 +90,33 @@ public:
 	inline
 	context(ipgraph_module & im)
 	: module_(im)
+	, globals_(nullptr)
 	, node_(nullptr)
 	, iostate_(nullptr)
 	, loop_state_(nullptr)
 	, memory_state_(nullptr)
 	{}
 
+	/**
+	* Creates a context for the conversion of the body of \p node. Values are inserted into the
+	* new context, while values that are not found in it are looked up in \p globals. The values
+	* of \p globals are only read, which permits to convert several function bodies concurrently.
+	*/
+	inline
+	context(context & globals, ipgraph_node * node)
+	: module_(globals.module_)
+	, globals_(&globals)
+	, node_(node)
+	, iostate_(nullptr)
+	, loop_state_(nullptr)
+	, memory_state_(nullptr)
+	{}
+
+	context(const context&) = delete;
+
+	context &
+	operator=(const context&) = delete;
+
 	const jlm::variable *
 	result() const noexcept
 	{
@@ -176,14 +198,18 @@ public:
 	inline bool
 	has_value(const llvm::Value * value) const noexcept
 	{
-		return vmap_.find(value) != vmap_.end();
+		if (vmap_.find(value) != vmap_.end())
+			return true;
+
+		return globals_ && globals_->has_value(value);
 	}
 
 	inline const jlm::variable *
 	lookup_value(const llvm::Value * value) const noexcept
 	{
 		JLM_ASSERT(has_value(value));
-		return vmap_.find(value)->second;
+		auto it = vmap_.find(value);
+		return it != vmap_.end() ? it->second : globals_->lookup_value(value);
 	}
 
 	inline void
@@ -193,11 +219,26 @@ public:
 		vmap_[value] = variable;
 	}
 
+	/**
+	* Returns the mutex that serializes all operations that mutate the LLVM context, such as the
+	* creation of constants. It is shared by a context and all contexts layered over it.
+	*/
+	inline std::recursive_mutex &
+	llvm_mutex() noexcept
+	{
+		return globals_ ? globals_->llvm_mutex() : llvm_mutex_;
+	}
+
 	inline const jive::rcddeclaration *
 	lookup_declaration(const llvm::StructType * type)
 	{
+		if (globals_)
+			return globals_->lookup_declaration(type);
+
 		/* FIXME: They live as long as jlm is alive. */
 		static std::vector<std::unique_ptr<jive::rcddeclaration>> dcls;
+		static std::recursive_mutex mutex;
+		std::lock_guard<std::recursive_mutex> guard(mutex);
 
 		auto it = declarations_.find(type);
 		if (it != declarations_.end())
@@ -232,6 +273,7 @@ public:
 
 private:
 	ipgraph_module & module_;
+	context * globals_;
 	basic_block_map bbmap_;
 	ipgraph_node * node_;
 	const jlm::variable * result_;
@@ -242,6 +284,7 @@ private:
 	std::unordered_map<
 		const llvm::StructType*,
 		const jive::rcddeclaration*> declarations_;
+	std::recursive_mutex llvm_mutex_;
 };
 
 }
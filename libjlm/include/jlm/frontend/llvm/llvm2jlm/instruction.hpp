@@ -15,8 +15,16 @@ namespace llvm {
 namespace jlm  {
 
 class context;
+class ipgraph_node;
 class variable;
 
+/**
+* Records the function or global variable that \p v refers to as a dependency of \p node. Other
+* values are ignored.
+*/
+void
+add_dependency(ipgraph_node & node, const llvm::Value * v, const context & ctx);
+
 const variable *
 convert_value(
 	llvm::Value * v,
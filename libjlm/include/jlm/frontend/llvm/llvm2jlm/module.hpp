@@ -7,18 +7,63 @@
 #define JLM_FRONTEND_LLVM_LLVM2JLM_MODULE_HPP
 
 #include <memory>
+#include <unordered_map>
 
 namespace llvm {
+	class Function;
 	class Module;
 }
 
 namespace jlm {
 
+class context;
+class function_node;
 class ipgraph_module;
 
 std::unique_ptr<ipgraph_module>
 convert_module(llvm::Module & module);
 
+/**
+* \brief Converts an LLVM module one function at a time.
+*
+* The constructor converts all declarations and global variable initializations, and records the
+* dependencies of every function without converting its body. The dependencies are collected
+* from \p scan, a second lazily loaded copy of the same input, whose bodies are materialized and
+* deleted one at a time. The bodies of \p module are only materialized by materialize(), which
+* converts a body to a CFG and deletes it afterwards. The CFG is dropped again by release().
+* Together with the ipgraph SCCs, this permits to only keep a single LLVM body and the CFGs of a
+* single SCC alive at any time. The LLVM module must outlive the converter, while the scan module
+* is only needed by the constructor.
+*/
+class lazy_module_converter final {
+public:
+	~lazy_module_converter();
+
+	lazy_module_converter(llvm::Module & module, llvm::Module & scan);
+
+	lazy_module_converter(const lazy_module_converter&) = delete;
+
+	lazy_module_converter &
+	operator=(const lazy_module_converter&) = delete;
+
+	ipgraph_module &
+	module() const noexcept
+	{
+		return *im_;
+	}
+
+	void
+	materialize(const function_node & node);
+
+	void
+	release(function_node & node);
+
+private:
+	std::unique_ptr<ipgraph_module> im_;
+	std::unique_ptr<context> ctx_;
+	std::unordered_map<const function_node*, llvm::Function*> functions_;
+};
+
 }
 
 #endif
@@ -205,14 +205,7 @@ public:
 	* Return the number of nodes of the entire subtree.
 	*/
 	size_t
-	nnodes() const noexcept
-	{
-		size_t n = 1;
-		for (auto & child : children_)
-			n += child->nnodes();
-
-		return n;
-	}
+	nnodes() const noexcept;
 
 	virtual std::string
 	debug_string() const = 0;
@@ -252,6 +252,28 @@ purge(jlm::cfg & cfg);
 void
 prune(jlm::cfg & cfg);
 
+/**
+* Removes all nodes that are unreachable from the entry, merges linear chains of basic blocks,
+* and removes empty basic blocks if \p purge is true. Blocks that start with a phi are neither
+* merged with their predecessor nor the target of a purged block. The nodes are only numbered
+* once and every block is revisited only if one of its neighbours was removed.
+*/
+void
+simplify(jlm::cfg & cfg, bool purge);
+
+/**
+* Threads control flow through branches on control constants. A branch on a constant is
+* replaced by an unconditional edge. A predecessor of a predicate block, i.e., a block that only
+* consists of phis and a branch on one of them, is redirected to the selected successor if it
+* contributes a constant to the branch predicate. The CFG is simplified afterwards with
+* simplify(), which removes unreachable blocks and merges linear chains of basic blocks.
+*
+* Such branches are created by the restructuring of unstructured control flow, and survive the
+* RVSDG as chains of control constants and gammas.
+*/
+void
+thread_branches(jlm::cfg & cfg);
+
 }
 
 #endif
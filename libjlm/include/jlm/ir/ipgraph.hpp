@@ -123,6 +123,12 @@ public:
 	std::vector<std::unordered_set<const ipgraph_node*>>
 	find_sccs() const;
 
+	/**
+	* Returns the same SCCs as the const overload, but permits to modify their nodes.
+	*/
+	std::vector<std::unordered_set<ipgraph_node*>>
+	find_sccs();
+
 	const ipgraph_node *
 	find(const std::string & name) const noexcept;
 
@@ -249,6 +255,16 @@ public:
 	void
 	add_cfg(std::unique_ptr<jlm::cfg> cfg);
 
+	/**
+	* \brief Removes the CFG from the function node. The function node is afterwards
+		indistinguishable from a function declaration.
+	**/
+	void
+	remove_cfg() noexcept
+	{
+		cfg_.reset();
+	}
+
 	static inline function_node *
 	create(
 		jlm::ipgraph & ipg,
@@ -13,6 +13,7 @@
 #include <jlm/ir/operators/getelementptr.hpp>
 #include <jlm/ir/operators/lambda.hpp>
 #include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/operators/operators.hpp>
 #include <jlm/ir/operators/phi.hpp>
 #include <jlm/ir/operators/sext.hpp>
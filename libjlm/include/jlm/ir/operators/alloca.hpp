@@ -12,6 +12,7 @@
 #include <jive/rvsdg/simple-normal-form.hpp>
 #include <jive/rvsdg/simple-node.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
 
@@ -19,7 +20,7 @@ namespace jlm {
 
 /* alloca operator */
 
-class alloca_op final : public jive::simple_op {
+class alloca_op final : public jive::simple_op, public with_opcode<opcode::alloca_op> {
 public:
 	virtual
 	~alloca_op() noexcept;
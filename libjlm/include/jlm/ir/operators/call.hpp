@@ -9,6 +9,7 @@
 #include <jive/rvsdg/simple-node.hpp>
 #include <jive/types/function.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
 
@@ -20,7 +21,7 @@ namespace lambda {
 
 /* call operator */
 
-class call_op final : public jive::simple_op {
+class call_op final : public jive::simple_op, public with_opcode<opcode::call_op> {
 public:
 	virtual
 	~call_op();
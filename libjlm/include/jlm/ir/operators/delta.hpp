@@ -9,6 +9,7 @@
 #include <jive/rvsdg/region.hpp>
 #include <jive/rvsdg/structural-node.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/types.hpp>
 #include <jlm/ir/variable.hpp>
 #include <jlm/util/iterator_range.hpp>
@@ -18,7 +19,7 @@ namespace delta {
 
 /** \brief Delta operation
 */
-class operation final : public jive::structural_op {
+class operation final : public jive::structural_op, public with_opcode<opcode::delta> {
 public:
 	~operation() override;
 
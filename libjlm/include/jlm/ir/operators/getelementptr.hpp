@@ -9,6 +9,7 @@
 #include <jive/types/bitstring/type.hpp>
 #include <jive/rvsdg/simple-node.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
 
@@ -16,7 +17,9 @@ namespace jlm {
 
 /* getelementptr operator */
 
-class getelementptr_op final : public jive::simple_op {
+class getelementptr_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::getelementptr_op> {
 public:
 	virtual
 	~getelementptr_op();
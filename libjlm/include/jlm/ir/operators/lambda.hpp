@@ -8,6 +8,7 @@
 
 #include <jlm/ir/attribute.hpp>
 #include <jlm/ir/linkage.hpp>
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/types.hpp>
 #include <jlm/util/iterator_range.hpp>
 
@@ -21,7 +22,7 @@ namespace lambda {
 *
 * A lamba operation determines a lambda's name and \ref fcttype "function type".
 */
-class operation final : public jive::structural_op {
+class operation final : public jive::structural_op, public with_opcode<opcode::lambda> {
 public:
 	~operation() override;
 
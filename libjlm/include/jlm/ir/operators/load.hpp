@@ -11,6 +11,7 @@
 #include <jive/rvsdg/simple-normal-form.hpp>
 #include <jive/rvsdg/simple-node.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
 
@@ -133,7 +134,7 @@ private:
 
 /* load operator */
 
-class load_op final : public jive::simple_op {
+class load_op final : public jive::simple_op, public with_opcode<opcode::load_op> {
 public:
 	virtual
 	~load_op() noexcept;
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_OPERATORS_OPCODE_HPP
+#define JLM_IR_OPERATORS_OPCODE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace jive {
+	class operation;
+}
+
+namespace jlm {
+
+/*
+	Lists all operations with an opcode as pairs of opcode name and operation class. Expanding a
+	list with a macro that takes both arguments generates the opcode enumeration and its lookup
+	tables, and can be used to generate further dispatch tables. The jive operations are listed
+	separately from the jlm operations, as only the latter store their opcode.
+*/
+#define JLM_JIVE_OPCODES(X) \
+	/* structural operations */ \
+	X(gamma_op, jive::gamma_op) \
+	X(phi, jive::phi::operation) \
+	X(theta_op, jive::theta_op) \
+	/* bitstring and control operations */ \
+	X(bitadd_op, jive::bitadd_op) \
+	X(bitand_op, jive::bitand_op) \
+	X(bitashr_op, jive::bitashr_op) \
+	X(bitmul_op, jive::bitmul_op) \
+	X(bitor_op, jive::bitor_op) \
+	X(bitsdiv_op, jive::bitsdiv_op) \
+	X(bitshl_op, jive::bitshl_op) \
+	X(bitshr_op, jive::bitshr_op) \
+	X(bitsmod_op, jive::bitsmod_op) \
+	X(bitsub_op, jive::bitsub_op) \
+	X(bitudiv_op, jive::bitudiv_op) \
+	X(bitumod_op, jive::bitumod_op) \
+	X(bitxor_op, jive::bitxor_op) \
+	X(biteq_op, jive::biteq_op) \
+	X(bitne_op, jive::bitne_op) \
+	X(bitsge_op, jive::bitsge_op) \
+	X(bitsgt_op, jive::bitsgt_op) \
+	X(bitsle_op, jive::bitsle_op) \
+	X(bitslt_op, jive::bitslt_op) \
+	X(bituge_op, jive::bituge_op) \
+	X(bitugt_op, jive::bitugt_op) \
+	X(bitule_op, jive::bitule_op) \
+	X(bitult_op, jive::bitult_op) \
+	X(bitconstant_op, jive::bitconstant_op) \
+	X(ctlconstant_op, jive::ctlconstant_op) \
+	X(match_op, jive::match_op)
+
+#define JLM_IR_OPCODES(X) \
+	/* structural operations */ \
+	X(delta, delta::operation) \
+	X(lambda, lambda::operation) \
+	/* simple operations */ \
+	X(alloca_op, alloca_op) \
+	X(assignment_op, assignment_op) \
+	X(bitcast_op, bitcast_op) \
+	X(bits2ptr_op, bits2ptr_op) \
+	X(branch_op, branch_op) \
+	X(call_op, call_op) \
+	X(constant_aggregate_zero_op, constant_aggregate_zero_op) \
+	X(constant_data_vector_op, constant_data_vector_op) \
+	X(ConstantArray, ConstantArray) \
+	X(ConstantDataArray, ConstantDataArray) \
+	X(constantvector_op, constantvector_op) \
+	X(ctl2bits_op, ctl2bits_op) \
+	X(extractelement_op, extractelement_op) \
+	X(extractvalue_op, extractvalue_op) \
+	X(fp2si_op, fp2si_op) \
+	X(fp2ui_op, fp2ui_op) \
+	X(fpbin_op, fpbin_op) \
+	X(fpcmp_op, fpcmp_op) \
+	X(fpconstant_op, fpconstant_op) \
+	X(fpext_op, fpext_op) \
+	X(fpneg_op, fpneg_op) \
+	X(fptrunc_op, fptrunc_op) \
+	X(free_op, free_op) \
+	X(getelementptr_op, getelementptr_op) \
+	X(insertelement_op, insertelement_op) \
+	X(load_op, load_op) \
+	X(loopstatemux_op, loopstatemux_op) \
+	X(malloc_op, malloc_op) \
+	X(Memcpy, Memcpy) \
+	X(memstatemux_op, memstatemux_op) \
+	X(phi_op, phi_op) \
+	X(ptr2bits_op, ptr2bits_op) \
+	X(ptr_constant_null_op, ptr_constant_null_op) \
+	X(ptrcmp_op, ptrcmp_op) \
+	X(select_op, select_op) \
+	X(sext_op, sext_op) \
+	X(shufflevector_op, shufflevector_op) \
+	X(sitofp_op, sitofp_op) \
+	X(store_op, store_op) \
+	X(struct_constant_op, struct_constant_op) \
+	X(trunc_op, trunc_op) \
+	X(uitofp_op, uitofp_op) \
+	X(undef_constant_op, undef_constant_op) \
+	X(valist_op, valist_op) \
+	X(vectorbinary_op, vectorbinary_op) \
+	X(vectorselect_op, vectorselect_op) \
+	X(vectorunary_op, vectorunary_op) \
+	X(zext_op, zext_op)
+
+#define JLM_OPCODES(X) \
+	JLM_JIVE_OPCODES(X) \
+	JLM_IR_OPCODES(X)
+
+/**
+* \brief Dense operation codes
+*
+* Every jlm operation, every structural operation, and the jive operations that jlm dispatches on
+* have a dense opcode, such that dispatching on the operation kind can be done with a switch.
+* All other operations share opcode::other.
+*/
+enum class opcode : uint8_t {
+#define JLM_OPCODE_ENUMERATOR(name, operation) name,
+	JLM_OPCODES(JLM_OPCODE_ENUMERATOR)
+#undef JLM_OPCODE_ENUMERATOR
+	other
+};
+
+/**
+* \brief Operation that stores its opcode
+*
+* Every jlm operation derives from this class in addition to its jive base class.
+*/
+class opcode_operation {
+public:
+	jlm::opcode
+	code() const noexcept
+	{
+		return code_;
+	}
+
+protected:
+	constexpr
+	opcode_operation(jlm::opcode code) noexcept
+	: code_(code)
+	{}
+
+private:
+	jlm::opcode code_;
+};
+
+/**
+* Sets the opcode of a jlm operation to \p Code on construction, such that the constructors of
+* the operation classes do not need to pass it on.
+*/
+template<opcode Code>
+class with_opcode : public opcode_operation {
+protected:
+	constexpr
+	with_opcode() noexcept
+	: opcode_operation(Code)
+	{}
+};
+
+/**
+* Returns the opcode of \p operation. The opcodes of the jlm operations are read from the
+* operations. The jive operations do not store an opcode, and are compared against the listed
+* jive operation classes instead.
+*/
+opcode
+get_opcode(const jive::operation & operation);
+
+/**
+* Returns a hash of \p operation. It combines the opcode with the parameters of the operation
+* that are not determined by its class, e.g., the value of a constant or the alignment of a
+* load. Equal operations have equal hashes.
+*/
+size_t
+hash(const jive::operation & operation);
+
+}
+
+#endif
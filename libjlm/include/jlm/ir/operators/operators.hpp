@@ -18,6 +18,7 @@
 #include <jive/rvsdg/unary.hpp>
 
 #include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
 
@@ -29,7 +30,7 @@ class cfg_node;
 
 /* phi operator */
 
-class phi_op final : public jive::simple_op {
+class phi_op final : public jive::simple_op, public with_opcode<opcode::phi_op> {
 public:
 	virtual
 	~phi_op() noexcept;
@@ -92,7 +93,7 @@ private:
 
 /* assignment operator */
 
-class assignment_op final : public jive::simple_op {
+class assignment_op final : public jive::simple_op, public with_opcode<opcode::assignment_op> {
 public:
 	virtual
 	~assignment_op() noexcept;
@@ -127,7 +128,7 @@ public:
 
 /* select operator */
 
-class select_op final : public jive::simple_op {
+class select_op final : public jive::simple_op, public with_opcode<opcode::select_op> {
 public:
 	virtual
 	~select_op() noexcept;
@@ -164,7 +165,7 @@ public:
 
 /* vector select operator */
 
-class vectorselect_op final : public jive::simple_op {
+class vectorselect_op final : public jive::simple_op, public with_opcode<opcode::vectorselect_op> {
 public:
 	virtual
 	~vectorselect_op() noexcept;
@@ -217,7 +218,7 @@ public:
 
 /* fp2ui operator */
 
-class fp2ui_op final : public jive::unary_op {
+class fp2ui_op final : public jive::unary_op, public with_opcode<opcode::fp2ui_op> {
 public:
 	virtual
 	~fp2ui_op() noexcept;
@@ -276,7 +277,7 @@ public:
 
 /* fp2si operator */
 
-class fp2si_op final : public jive::unary_op {
+class fp2si_op final : public jive::unary_op, public with_opcode<opcode::fp2si_op> {
 public:
 	virtual
 	~fp2si_op() noexcept;
@@ -335,7 +336,7 @@ public:
 
 /* ctl2bits operator */
 
-class ctl2bits_op final : public jive::simple_op {
+class ctl2bits_op final : public jive::simple_op, public with_opcode<opcode::ctl2bits_op> {
 public:
 	virtual
 	~ctl2bits_op() noexcept;
@@ -372,7 +373,7 @@ public:
 
 /* branch operator */
 
-class branch_op final : public jive::simple_op {
+class branch_op final : public jive::simple_op, public with_opcode<opcode::branch_op> {
 public:
 	virtual
 	~branch_op() noexcept;
@@ -408,7 +409,9 @@ public:
 
 /* ptr constant */
 
-class ptr_constant_null_op final : public jive::simple_op {
+class ptr_constant_null_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::ptr_constant_null_op> {
 public:
 	virtual
 	~ptr_constant_null_op() noexcept;
@@ -464,7 +467,7 @@ private:
 
 /* bits2ptr operator */
 
-class bits2ptr_op final : public jive::unary_op {
+class bits2ptr_op final : public jive::unary_op, public with_opcode<opcode::bits2ptr_op> {
 public:
 	virtual
 	~bits2ptr_op();
@@ -550,7 +553,7 @@ public:
 
 /* ptr2bits operator */
 
-class ptr2bits_op final : public jive::unary_op {
+class ptr2bits_op final : public jive::unary_op, public with_opcode<opcode::ptr2bits_op> {
 public:
 	virtual
 	~ptr2bits_op();
@@ -621,7 +624,9 @@ public:
 
 /* Constant Data Array operator */
 
-class ConstantDataArray final : public jive::simple_op {
+class ConstantDataArray final
+	: public jive::simple_op
+	, public with_opcode<opcode::ConstantDataArray> {
 public:
 	virtual
 	~ConstantDataArray();
@@ -672,7 +677,7 @@ public:
 
 enum class cmp {eq, ne, gt, ge, lt, le};
 
-class ptrcmp_op final : public jive::binary_op {
+class ptrcmp_op final : public jive::binary_op, public with_opcode<opcode::ptrcmp_op> {
 public:
 	virtual
 	~ptrcmp_op();
@@ -734,7 +739,7 @@ private:
 
 /* zext operator */
 
-class zext_op final : public jive::unary_op {
+class zext_op final : public jive::unary_op, public with_opcode<opcode::zext_op> {
 public:
 	virtual
 	~zext_op();
@@ -810,7 +815,7 @@ public:
 
 /* floating point constant operator */
 
-class fpconstant_op final : public jive::simple_op {
+class fpconstant_op final : public jive::simple_op, public with_opcode<opcode::fpconstant_op> {
 public:
 	virtual
 	~fpconstant_op();
@@ -866,7 +871,7 @@ enum class fpcmp {
 	TRUE, FALSE, oeq, ogt, oge, olt, ole, one, ord, ueq, ugt, uge, ult, ule, une, uno
 };
 
-class fpcmp_op final : public jive::binary_op {
+class fpcmp_op final : public jive::binary_op, public with_opcode<opcode::fpcmp_op> {
 public:
 	virtual
 	~fpcmp_op();
@@ -928,7 +933,9 @@ private:
 
 /* undef constant operator */
 
-class undef_constant_op final : public jive::simple_op {
+class undef_constant_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::undef_constant_op> {
 public:
 	virtual
 	~undef_constant_op();
@@ -1011,7 +1018,7 @@ private:
 
 enum class fpop {add, sub, mul, div, mod};
 
-class fpbin_op final : public jive::binary_op {
+class fpbin_op final : public jive::binary_op, public with_opcode<opcode::fpbin_op> {
 public:
 	virtual
 	~fpbin_op();
@@ -1073,7 +1080,7 @@ private:
 
 /* fpext operator */
 
-class fpext_op final : public jive::unary_op {
+class fpext_op final : public jive::unary_op, public with_opcode<opcode::fpext_op> {
 public:
 	virtual
 	~fpext_op();
@@ -1150,7 +1157,7 @@ public:
 
 /* fpneg operator */
 
-class fpneg_op final : public jive::unary_op {
+class fpneg_op final : public jive::unary_op, public with_opcode<opcode::fpneg_op> {
 public:
 	~fpneg_op() override;
 
@@ -1202,7 +1209,7 @@ public:
 
 /* fptrunc operator */
 
-class fptrunc_op final : public jive::unary_op {
+class fptrunc_op final : public jive::unary_op, public with_opcode<opcode::fptrunc_op> {
 public:
 	virtual
 	~fptrunc_op();
@@ -1283,7 +1290,7 @@ public:
 
 /* valist operator */
 
-class valist_op final : public jive::simple_op {
+class valist_op final : public jive::simple_op, public with_opcode<opcode::valist_op> {
 public:
 	virtual
 	~valist_op();
@@ -1335,7 +1342,7 @@ private:
 
 /* bitcast operator */
 
-class bitcast_op final : public jive::unary_op {
+class bitcast_op final : public jive::unary_op, public with_opcode<opcode::bitcast_op> {
 public:
 	virtual
 	~bitcast_op();
@@ -1418,7 +1425,9 @@ private:
 
 /* struct constant operator */
 
-class struct_constant_op final : public jive::simple_op {
+class struct_constant_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::struct_constant_op> {
 public:
 	virtual
 	~struct_constant_op();
@@ -1469,7 +1478,7 @@ private:
 
 /* trunc operator */
 
-class trunc_op final : public jive::unary_op {
+class trunc_op final : public jive::unary_op, public with_opcode<opcode::trunc_op> {
 public:
 	virtual
 	~trunc_op();
@@ -1558,7 +1567,7 @@ public:
 
 /* uitofp operator */
 
-class uitofp_op final : public jive::unary_op {
+class uitofp_op final : public jive::unary_op, public with_opcode<opcode::uitofp_op> {
 public:
 	virtual
 	~uitofp_op();
@@ -1616,7 +1625,7 @@ public:
 
 /* sitofp operator */
 
-class sitofp_op final : public jive::unary_op {
+class sitofp_op final : public jive::unary_op, public with_opcode<opcode::sitofp_op> {
 public:
 	virtual
 	~sitofp_op();
@@ -1675,7 +1684,7 @@ public:
 
 /* ConstantArray */
 
-class ConstantArray final : public jive::simple_op {
+class ConstantArray final : public jive::simple_op, public with_opcode<opcode::ConstantArray> {
 public:
 	virtual
 	~ConstantArray();
@@ -1724,7 +1733,9 @@ public:
 
 /* constant aggregate zero */
 
-class constant_aggregate_zero_op final : public jive::simple_op {
+class constant_aggregate_zero_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::constant_aggregate_zero_op> {
 public:
 	virtual
 	~constant_aggregate_zero_op();
@@ -1759,7 +1770,9 @@ public:
 
 /* extractelement operator */
 
-class extractelement_op final : public jive::simple_op {
+class extractelement_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::extractelement_op> {
 public:
 	virtual
 	~extractelement_op();
@@ -1798,7 +1811,9 @@ public:
 
 /* shufflevector operator */
 
-class shufflevector_op final : public jive::simple_op {
+class shufflevector_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::shufflevector_op> {
 public:
 	virtual
 	~shufflevector_op();
@@ -1845,7 +1860,9 @@ public:
 
 /* constantvector operator */
 
-class constantvector_op final : public jive::simple_op {
+class constantvector_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::constantvector_op> {
 public:
 	virtual
 	~constantvector_op();
@@ -1880,7 +1897,9 @@ public:
 
 /* insertelement operator */
 
-class insertelement_op final : public jive::simple_op {
+class insertelement_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::insertelement_op> {
 public:
 	virtual
 	~insertelement_op();
@@ -1930,7 +1949,7 @@ public:
 
 /* vectorunary operator */
 
-class vectorunary_op final : public jive::simple_op {
+class vectorunary_op final : public jive::simple_op, public with_opcode<opcode::vectorunary_op> {
 public:
 	virtual
 	~vectorunary_op();
@@ -2021,7 +2040,7 @@ private:
 
 /* vectorbinary operator */
 
-class vectorbinary_op final : public jive::simple_op {
+class vectorbinary_op final : public jive::simple_op, public with_opcode<opcode::vectorbinary_op> {
 public:
 	virtual
 	~vectorbinary_op();
@@ -2118,7 +2137,9 @@ private:
 
 /* constant data vector operator */
 
-class constant_data_vector_op final : public jive::simple_op {
+class constant_data_vector_op final
+	: public jive::simple_op
+	, public with_opcode<opcode::constant_data_vector_op> {
 public:
 	virtual
 	~constant_data_vector_op();
@@ -2168,7 +2189,7 @@ public:
 
 /* extractvalue operator */
 
-class extractvalue_op final : public jive::simple_op {
+class extractvalue_op final : public jive::simple_op, public with_opcode<opcode::extractvalue_op> {
 	typedef std::vector<unsigned>::const_iterator const_iterator;
 public:
 	virtual
@@ -2245,7 +2266,7 @@ private:
 
 /* loop state mux operator */
 
-class loopstatemux_op final : public jive::simple_op {
+class loopstatemux_op final : public jive::simple_op, public with_opcode<opcode::loopstatemux_op> {
 public:
 	virtual
 	~loopstatemux_op();
@@ -2304,7 +2325,7 @@ private:
 
 /* memory state mux operator */
 
-class memstatemux_op final : public jive::simple_op {
+class memstatemux_op final : public jive::simple_op, public with_opcode<opcode::memstatemux_op> {
 public:
 	virtual
 	~memstatemux_op();
@@ -2376,7 +2397,7 @@ private:
 
 /* malloc operator */
 
-class malloc_op final : public jive::simple_op {
+class malloc_op final : public jive::simple_op, public with_opcode<opcode::malloc_op> {
 public:
 	virtual
 	~malloc_op();
@@ -2430,7 +2451,7 @@ public:
 
 /* free operator */
 
-class free_op final : public jive::simple_op {
+class free_op final : public jive::simple_op, public with_opcode<opcode::free_op> {
 public:
 	virtual
 	~free_op();
@@ -2517,7 +2538,7 @@ private:
 
 /* memcpy operation */
 
-class Memcpy final : public jive::simple_op {
+class Memcpy final : public jive::simple_op, public with_opcode<opcode::Memcpy> {
 public:
 	virtual
 	~Memcpy();
@@ -9,13 +9,14 @@
 #include <jive/types/bitstring.hpp>
 #include <jive/rvsdg/unary.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 
 namespace jlm {
 
 /* sext operator */
 
-class sext_op final : public jive::unary_op {
+class sext_op final : public jive::unary_op, public with_opcode<opcode::sext_op> {
 public:
 	virtual
 	~sext_op();
@@ -11,6 +11,7 @@
 #include <jive/rvsdg/simple-normal-form.hpp>
 #include <jive/rvsdg/simple-node.hpp>
 
+#include <jlm/ir/operators/opcode.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
 
@@ -82,7 +83,7 @@ private:
 
 /* store operator */
 
-class store_op final : public jive::simple_op {
+class store_op final : public jive::simple_op, public with_opcode<opcode::store_op> {
 public:
 	virtual
 	~store_op() noexcept;
@@ -11,6 +11,9 @@
 #include <jlm/ir/linkage.hpp>
 #include <jlm/util/file.hpp>
 
+#include <deque>
+#include <unordered_set>
+
 namespace jlm {
 
 /* impport class */
@@ -82,15 +85,12 @@ is_export(const jive::input * input)
 
 class rvsdg_module final {
 public:
-	inline
+	~rvsdg_module();
+
 	rvsdg_module(
 		const jlm::filepath & source_filename,
 		const std::string & target_triple,
-		const std::string & data_layout)
-	: data_layout_(data_layout)
-	, target_triple_(target_triple)
-	, source_filename_(source_filename)
-	{}
+		const std::string & data_layout);
 
 	rvsdg_module(const rvsdg_module &) = delete;
 
@@ -132,6 +132,55 @@ public:
 		return data_layout_;
 	}
 
+	/**
+	* Returns the number of nodes in the graph, including the nodes of all subregions. The number
+	* is maintained incrementally as nodes are created and removed.
+	*/
+	size_t
+	nnodes() const noexcept
+	{
+		return nnodes_;
+	}
+
+	/**
+	* Returns true if the module records touched nodes. A node is touched if it is created or one
+	* of its operands is diverted. A structural node is also touched if the origin of one of its
+	* subregion results is diverted.
+	*/
+	bool
+	records_touched_nodes() const noexcept
+	{
+		return record_touched_;
+	}
+
+	/**
+	* Starts recording touched nodes. Nodes that exist before are not recorded.
+	*/
+	void
+	record_touched_nodes() noexcept
+	{
+		record_touched_ = true;
+	}
+
+	/**
+	* Records \p node as touched unless it is already recorded.
+	*/
+	void
+	touch(jive::node * node);
+
+	/**
+	* Returns and forgets the touched node that was recorded first, or nullptr if there is none.
+	*/
+	jive::node *
+	pop_touched_node();
+
+	void
+	clear_touched_nodes() noexcept
+	{
+		touched_.clear();
+		touched_set_.clear();
+	}
+
 	static std::unique_ptr<rvsdg_module>
 	create(
 		const jlm::filepath & source_filename,
@@ -142,12 +191,26 @@ public:
 	}
 
 private:
+	friend class graph_observer;
+
 	jive::graph graph_;
+	size_t nnodes_;
+	bool record_touched_;
+	std::deque<jive::node*> touched_;
+	std::unordered_set<const jive::node*> touched_set_;
 	std::string data_layout_;
 	std::string target_triple_;
 	const jlm::filepath source_filename_;
 };
 
+/**
+* Returns the number of nodes in \p graph, including the nodes of all subregions. The number is
+* read from the owning RVSDG module if there is one, and computed by traversing all regions
+* otherwise.
+*/
+size_t
+nnodes(const jive::graph & graph);
+
 }
 
 #endif
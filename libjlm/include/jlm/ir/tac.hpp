@@ -11,6 +11,7 @@
 
 #include <jive/rvsdg/operation.hpp>
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <vector>
@@ -187,7 +188,8 @@ private:
 	static std::vector<std::string>
 	create_names(size_t nnames)
 	{
-		static size_t c = 0;
+		/* tacs are created concurrently by the parallel conversion of function bodies */
+		static std::atomic<size_t> c(0);
 		std::vector<std::string> names;
 		for (size_t n = 0; n < nnames; n++)
 			names.push_back(strfmt("tv", c++));
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_DAE_HPP
+#define JLM_OPT_DAE_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Dead Argument Elimination
+*
+* Removes unused function arguments and function results from lambdas that are only directly
+* called. The lambda is replaced by a lambda with a reduced function type, and all its call
+* sites are rewritten to the new lambda. Lambdas within phi regions are handled by rebuilding
+* the entire phi node. The now dead computations of the arguments in the callers are left for
+* dead node elimination.
+*/
+class dae final : public optimization {
+public:
+	virtual
+	~dae();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_DEVIRTUALIZATION_HPP
+#define JLM_OPT_DEVIRTUALIZATION_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+#include <stddef.h>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Indirect Call Promotion
+*
+* Promotes indirect calls with a small set of known targets to guarded direct calls. The
+* targets of a call are found by tracing its function operand through gamma exit variables,
+* select operations, and loads from constant deltas that contain a function or a table of
+* functions. A call with at most \p ntargets targets is replaced by a cascade of gammas that
+* compare the function operand to each target and call it directly.
+*/
+class devirtualization final : public optimization {
+public:
+	virtual
+	~devirtualization();
+
+	constexpr
+	devirtualization(size_t ntargets)
+	: ntargets_(ntargets)
+	{}
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	size_t ntargets_;
+};
+
+}
+
+#endif
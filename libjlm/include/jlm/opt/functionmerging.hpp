@@ -0,0 +1,36 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_FUNCTIONMERGING_HPP
+#define JLM_OPT_FUNCTIONMERGING_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Identical Function Merging
+*
+* Merges lambdas with structurally identical bodies. Lambdas are bucketed by a structural hash of
+* their subregions and context variable origins, and every candidate pair is verified for
+* equivalence before merging. Internal duplicates that are only directly called are replaced by
+* a canonical lambda, while all other duplicates are replaced by a lambda of the same name and
+* linkage that forwards the call to the canonical lambda.
+*/
+class functionmerging final : public optimization {
+public:
+	virtual
+	~functionmerging();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_GAMMAFUSION_HPP
+#define JLM_OPT_GAMMAFUSION_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Gamma Fusion
+*
+* Merges gammas of the same region into a single gamma. Two gammas are fused if their
+* predicates are congruent, i.e., they are the same value or computed by identical operations
+* from the same operands. The subregions of one gamma are then copied into the corresponding
+* subregions of the other gamma. Moreover, a gamma whose predicate is an output of a preceding
+* gamma that produces a control constant in each of its subregions is threaded into the
+* preceding gamma: each subregion of the preceding gamma receives a copy of the selected
+* subregion. Gammas are only merged if this introduces no cycles.
+*/
+class gammafusion final : public optimization {
+public:
+	virtual
+	~gammafusion();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
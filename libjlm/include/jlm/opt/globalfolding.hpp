@@ -0,0 +1,35 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_GLOBALFOLDING_HPP
+#define JLM_OPT_GLOBALFOLDING_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Constant Global Folding
+*
+* Marks internal deltas as constant if their address is only ever used to load from them, i.e.,
+* it is never stored, passed to a call, exported, or used in another delta's initializer. Loads
+* from constant deltas at constant offsets are then replaced by the corresponding element of the
+* delta's initializer.
+*/
+class globalfolding final : public optimization {
+public:
+	virtual
+	~globalfolding();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
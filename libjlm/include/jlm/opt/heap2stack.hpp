@@ -0,0 +1,46 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_HEAP2STACK_HPP
+#define JLM_OPT_HEAP2STACK_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+#include <stddef.h>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Heap-to-Stack Promotion
+*
+* Replaces mallocs of a constant size of at most \p limit bytes with allocas. A malloc is only
+* replaced if it is in the region of a lambda, its pointer does not escape the lambda, and it is
+* freed exactly once in the same region. The pointer does not escape if it, and all pointers
+* derived from it by getelementptrs and bitcasts, are only used as addresses of loads, stores,
+* and memcpys, or by the free. The free is removed.
+*/
+class heap2stack final : public optimization {
+public:
+	virtual
+	~heap2stack();
+
+	constexpr
+	heap2stack(size_t limit)
+	: limit_(limit)
+	{}
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	size_t limit_;
+};
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_IFCONVERSION_HPP
+#define JLM_OPT_IFCONVERSION_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+#include <stddef.h>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief If-Conversion
+*
+* Converts two-way gammas with small and side-effect free subregions to select operations. The
+* nodes of both subregions are speculatively computed in the gamma's region, and each gamma
+* output is replaced by a select between the two computed values. A gamma is only converted if
+* its subregions contain no more than \p threshold nodes in total.
+*/
+class ifconversion final : public optimization {
+public:
+	virtual
+	~ifconversion();
+
+	constexpr
+	ifconversion(size_t threshold)
+	: threshold_(threshold)
+	{}
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	size_t threshold_;
+};
+
+}
+
+#endif
@@ -8,6 +8,11 @@
 
 #include <jlm/opt/optimization.hpp>
 
+namespace jive {
+	class output;
+	class region;
+}
+
 namespace jlm {
 
 class rvsdg_module;
@@ -25,6 +30,18 @@ public:
 	run(rvsdg_module & module, const stats_descriptor & sd) override;
 };
 
+/**
+* Routes \p output into \p region by adding entry variables, loop variables, and context
+* variables to all structural nodes between the region of \p output and \p region.
+*
+* \param output An output from the region \p region is (transitively) nested in.
+* \param region The region in which \p output is required.
+*
+* \return The routed output in \p region.
+*/
+jive::output *
+route_to_region(jive::output * output, jive::region * region);
+
 }
 
 #endif
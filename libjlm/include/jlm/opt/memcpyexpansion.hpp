@@ -0,0 +1,46 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_MEMCPYEXPANSION_HPP
+#define JLM_OPT_MEMCPYEXPANSION_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+#include <stddef.h>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Memcpy Expansion
+*
+* Expands non-volatile memcpys with a constant length of at most \p limit bytes into sequences
+* of loads and stores. The copied memory is split into the largest possible integer chunks of
+* at most 64 bits. A load of an expansion is replaced by the value of the closest preceding store
+* to the same chunk of the same address, which forwards the values that are copied through
+* temporaries. Moreover, all stores and memcpys to allocas that are never read are removed.
+*/
+class memcpyexpansion final : public optimization {
+public:
+	virtual
+	~memcpyexpansion();
+
+	constexpr
+	memcpyexpansion(size_t limit)
+	: limit_(limit)
+	{}
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	size_t limit_;
+};
+
+}
+
+#endif
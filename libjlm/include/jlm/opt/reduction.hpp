@@ -15,14 +15,28 @@ class stats_descriptor;
 
 /**
 * \brief Node Reduction Optimization
+*
+* Applies the mux, load, store, gamma, unary, and binary reductions. By default, only nodes that
+* were created or whose operands changed since the last reduction of the graph are reduced, and
+* the users of rewritten nodes are reduced in turn until no further reductions apply. The first
+* reduction of a graph considers all its nodes. If \p sweep is true, every reduction normalizes
+* the entire graph instead.
 */
 class nodereduction final : public optimization {
 public:
 	virtual
 	~nodereduction();
 
+	constexpr
+	nodereduction(bool sweep = false)
+	: sweep_(sweep)
+	{}
+
 	virtual void
 	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	bool sweep_;
 };
 
 }
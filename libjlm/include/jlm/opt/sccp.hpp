@@ -0,0 +1,36 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_SCCP_HPP
+#define JLM_OPT_SCCP_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Sparse Conditional Constant Propagation
+*
+* Propagates bit and control constants through the entire RVSDG. The analysis is optimistic
+* and interprocedural: The function arguments of lambdas that are only directly called are
+* the meet of all call-site operands, and only the subregions of a gamma that are selected
+* by its predicate contribute to the gamma's outputs. Gammas with a constant predicate are
+* replaced by the content of their selected subregion.
+*/
+class sccp final : public optimization {
+public:
+	virtual
+	~sccp();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
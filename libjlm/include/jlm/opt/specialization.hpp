@@ -0,0 +1,49 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_SPECIALIZATION_HPP
+#define JLM_OPT_SPECIALIZATION_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+#include <stddef.h>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Function Specialization
+*
+* Creates specialized copies of lambdas that are only directly called. The direct calls of a
+* lambda are grouped by the constant arguments they pass, and each group is redirected to a
+* copy of the lambda in which these arguments are replaced by the constants. Only groups with
+* at least \p mincalls calls are specialized, such that a copy is shared by recurring constant
+* arguments. Groups with more calls are specialized first. The total number of copied nodes is
+* limited by a budget. Lambdas within phi regions are not specialized.
+*/
+class fctspecialization final : public optimization {
+public:
+	virtual
+	~fctspecialization();
+
+	constexpr
+	fctspecialization(size_t budget, size_t mincalls = 2)
+	: budget_(budget)
+	, mincalls_(mincalls)
+	{}
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	size_t budget_;
+	size_t mincalls_;
+};
+
+}
+
+#endif
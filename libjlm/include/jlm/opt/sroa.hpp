@@ -0,0 +1,37 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_SROA_HPP
+#define JLM_OPT_SROA_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Scalar Replacement of Aggregates
+*
+* Splits allocas of struct and array type into one alloca per element if the address of the
+* alloca is only used by getelementptrs with constant indices. Afterwards, allocas whose
+* address is only used by loads and stores are promoted to values: the value of the alloca is
+* tracked along the memory states, routed through gammas and thetas, and the loads are replaced
+* by the tracked values. Addresses may be passed into gammas and thetas as entry variables and
+* invariant loop variables. The now dead allocas are left for dead node elimination.
+*/
+class sroa final : public optimization {
+public:
+	virtual
+	~sroa();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
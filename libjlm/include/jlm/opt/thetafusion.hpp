@@ -0,0 +1,40 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_THETAFUSION_HPP
+#define JLM_OPT_THETAFUSION_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Theta Fusion
+*
+* Merges sibling thetas that iterate over the same induction range into a single theta. The
+* ranges are determined with unrollinfo and must have the same init, step, and end values as
+* well as the same comparison and arithmetic operations. The body of the second theta is
+* executed after the body of the first theta in every iteration of the merged theta.
+*
+* Thetas are only fused if the second theta depends on the first theta only through states.
+* If one of the thetas stores to memory, then all memory accesses of both thetas must be
+* loads and stores to addresses that are indexed by the induction variable, and each pair of
+* accesses must either refer to the same element or to distinct objects.
+*/
+class thetafusion final : public optimization {
+public:
+	virtual
+	~thetafusion();
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_UNSWITCHING_HPP
+#define JLM_OPT_UNSWITCHING_HPP
+
+#include <jlm/opt/optimization.hpp>
+
+#include <stddef.h>
+
+namespace jlm {
+
+class rvsdg_module;
+class stats_descriptor;
+
+/**
+* \brief Loop Unswitching
+*
+* Hoists gammas with a loop-invariant predicate out of thetas. The theta is replaced by a gamma
+* that switches on the invariant predicate and contains a copy of the theta in each of its
+* subregions. In the copy of subregion n, the hoisted gamma is replaced by the content of its
+* subregion n. A theta is only unswitched if the size of its body multiplied by the number of
+* additional copies does not exceed \p budget nodes.
+*/
+class loopunswitching final : public optimization {
+public:
+	virtual
+	~loopunswitching();
+
+	constexpr
+	loopunswitching(size_t budget)
+	: budget_(budget)
+	{}
+
+	virtual void
+	run(rvsdg_module & module, const stats_descriptor & sd) override;
+
+private:
+	size_t budget_;
+};
+
+}
+
+#endif
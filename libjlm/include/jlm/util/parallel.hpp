@@ -0,0 +1,156 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_PARALLEL_HPP
+#define JLM_UTIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jlm {
+
+/**
+* Returns the maximum number of threads used by parallel_for and parallel_pipeline. It defaults
+* to the number of hardware threads, and can be overwritten, e.g., to obtain a serial reference
+* result. The function is not static, such that all translation units share the same limit.
+*/
+inline std::atomic<size_t> &
+maxthreads() noexcept
+{
+	static std::atomic<size_t> n(std::max(1u, std::thread::hardware_concurrency()));
+	return n;
+}
+
+static inline size_t
+nthreads(size_t nitems) noexcept
+{
+	size_t n = std::max(size_t(1), maxthreads().load());
+	return std::min(n, nitems);
+}
+
+/**
+* Invokes \p f for every index in [0, \p n). The invocations are distributed over all hardware
+* threads and must therefore be independent of each other. The first exception thrown by an
+* invocation is rethrown in the calling thread once all threads finished.
+*/
+static inline void
+parallel_for(size_t n, const std::function<void(size_t)> & f)
+{
+	if (nthreads(n) <= 1) {
+		for (size_t i = 0; i < n; i++)
+			f(i);
+		return;
+	}
+
+	std::mutex mutex;
+	std::atomic<size_t> next(0);
+	std::exception_ptr exception;
+	auto worker = [&]()
+	{
+		for (size_t i = next++; i < n; i = next++) {
+			try {
+				f(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> guard(mutex);
+				if (!exception)
+					exception = std::current_exception();
+				next = n;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < nthreads(n); t++)
+		threads.emplace_back(worker);
+	worker();
+
+	for (auto & thread : threads)
+		thread.join();
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+/**
+* Invokes \p produce for every index in [0, \p n) on worker threads, and \p consume for every
+* index in the calling thread. The consumptions happen in index order, each one as soon as the
+* production of its index finished. The productions must be independent of each other, while the
+* consumptions are serialized and can therefore access shared state. The first thrown exception
+* is rethrown in the calling thread once all threads finished.
+*/
+static inline void
+parallel_pipeline(
+	size_t n,
+	const std::function<void(size_t)> & produce,
+	const std::function<void(size_t)> & consume)
+{
+	if (nthreads(n) <= 1) {
+		for (size_t i = 0; i < n; i++) {
+			produce(i);
+			consume(i);
+		}
+		return;
+	}
+
+	std::mutex mutex;
+	std::condition_variable produced;
+	std::vector<bool> done(n, false);
+	std::atomic<size_t> next(0);
+	std::exception_ptr exception;
+	auto worker = [&]()
+	{
+		for (size_t i = next++; i < n; i = next++) {
+			try {
+				produce(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> guard(mutex);
+				if (!exception)
+					exception = std::current_exception();
+				next = n;
+			}
+
+			std::lock_guard<std::mutex> guard(mutex);
+			done[i] = true;
+			produced.notify_one();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < nthreads(n); t++)
+		threads.emplace_back(worker);
+
+	try {
+		for (size_t i = 0; i < n; i++) {
+			std::unique_lock<std::mutex> lock(mutex);
+			produced.wait(lock, [&](){ return done[i] || exception; });
+			if (exception)
+				break;
+			lock.unlock();
+
+			consume(i);
+		}
+	} catch (...) {
+		std::lock_guard<std::mutex> guard(mutex);
+		if (!exception)
+			exception = std::current_exception();
+		next = n;
+	}
+
+	for (auto & thread : threads)
+		thread.join();
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+}
+
+#endif
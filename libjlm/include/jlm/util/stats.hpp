@@ -28,14 +28,27 @@ public:
 	stats_descriptor(const jlm::filepath & path)
 	: print_cfr_time(false)
 	, print_cne_stat(false)
+	, print_dae_stat(false)
+	, print_devirtualization_stat(false)
 	, print_dne_stat(false)
+	, print_functionmerging_stat(false)
+	, print_gammafusion_stat(false)
+	, print_globalfolding_stat(false)
+	, print_heap2stack_stat(false)
+	, print_ifconversion_stat(false)
 	, print_iln_stat(false)
 	, print_inv_stat(false)
 	, print_ivt_stat(false)
+	, print_memcpyexpansion_stat(false)
 	, print_pull_stat(false)
 	, print_push_stat(false)
 	, print_reduction_stat(false)
+	, print_sccp_stat(false)
+	, print_specialization_stat(false)
+	, print_sroa_stat(false)
+	, print_thetafusion_stat(false)
 	, print_unroll_stat(false)
+	, print_unswitching_stat(false)
 	, print_annotation_time(false)
 	, print_aggregation_time(false)
 	, print_rvsdg_construction(false)
@@ -69,14 +82,27 @@ public:
 
 	bool print_cfr_time;
 	bool print_cne_stat;
+	bool print_dae_stat;
+	bool print_devirtualization_stat;
 	bool print_dne_stat;
+	bool print_functionmerging_stat;
+	bool print_gammafusion_stat;
+	bool print_globalfolding_stat;
+	bool print_heap2stack_stat;
+	bool print_ifconversion_stat;
 	bool print_iln_stat;
 	bool print_inv_stat;
 	bool print_ivt_stat;
+	bool print_memcpyexpansion_stat;
 	bool print_pull_stat;
 	bool print_push_stat;
 	bool print_reduction_stat;
+	bool print_sccp_stat;
+	bool print_specialization_stat;
+	bool print_sroa_stat;
+	bool print_thetafusion_stat;
 	bool print_unroll_stat;
+	bool print_unswitching_stat;
 	bool print_annotation_time;
 	bool print_aggregation_time;
 	bool print_rvsdg_construction;
@@ -50,26 +50,38 @@ convert_bitsbinary(
 {
 	JLM_ASSERT(dynamic_cast<const jive::bitbinary_op*>(&op));
 
-	static std::unordered_map<std::type_index, llvm::Instruction::BinaryOps> map({
-	  {typeid(jive::bitadd_op), llvm::Instruction::Add}
-	, {typeid(jive::bitand_op), llvm::Instruction::And}
-	, {typeid(jive::bitashr_op), llvm::Instruction::AShr}
-	, {typeid(jive::bitsub_op), llvm::Instruction::Sub}
-	, {typeid(jive::bitudiv_op), llvm::Instruction::UDiv}
-	, {typeid(jive::bitsdiv_op), llvm::Instruction::SDiv}
-	, {typeid(jive::bitumod_op), llvm::Instruction::URem}
-	, {typeid(jive::bitsmod_op), llvm::Instruction::SRem}
-	, {typeid(jive::bitshl_op), llvm::Instruction::Shl}
-	, {typeid(jive::bitshr_op), llvm::Instruction::LShr}
-	, {typeid(jive::bitor_op), llvm::Instruction::Or}
-	, {typeid(jive::bitxor_op), llvm::Instruction::Xor}
-	, {typeid(jive::bitmul_op), llvm::Instruction::Mul}
-	});
-
 	auto op1 = ctx.value(args[0]);
 	auto op2 = ctx.value(args[1]);
-	JLM_ASSERT(map.find(std::type_index(typeid(op))) != map.end());
-	return builder.CreateBinOp(map[std::type_index(typeid(op))], op1, op2);
+	switch (get_opcode(op)) {
+		case opcode::bitadd_op:
+			return builder.CreateBinOp(llvm::Instruction::Add, op1, op2);
+		case opcode::bitand_op:
+			return builder.CreateBinOp(llvm::Instruction::And, op1, op2);
+		case opcode::bitashr_op:
+			return builder.CreateBinOp(llvm::Instruction::AShr, op1, op2);
+		case opcode::bitsub_op:
+			return builder.CreateBinOp(llvm::Instruction::Sub, op1, op2);
+		case opcode::bitudiv_op:
+			return builder.CreateBinOp(llvm::Instruction::UDiv, op1, op2);
+		case opcode::bitsdiv_op:
+			return builder.CreateBinOp(llvm::Instruction::SDiv, op1, op2);
+		case opcode::bitumod_op:
+			return builder.CreateBinOp(llvm::Instruction::URem, op1, op2);
+		case opcode::bitsmod_op:
+			return builder.CreateBinOp(llvm::Instruction::SRem, op1, op2);
+		case opcode::bitshl_op:
+			return builder.CreateBinOp(llvm::Instruction::Shl, op1, op2);
+		case opcode::bitshr_op:
+			return builder.CreateBinOp(llvm::Instruction::LShr, op1, op2);
+		case opcode::bitor_op:
+			return builder.CreateBinOp(llvm::Instruction::Or, op1, op2);
+		case opcode::bitxor_op:
+			return builder.CreateBinOp(llvm::Instruction::Xor, op1, op2);
+		case opcode::bitmul_op:
+			return builder.CreateBinOp(llvm::Instruction::Mul, op1, op2);
+		default:
+			JLM_UNREACHABLE("Unhandled binary operation.");
+	}
 }
 
 static inline llvm::Value *
@@ -81,23 +93,32 @@ convert_bitscompare(
 {
 	JLM_ASSERT(dynamic_cast<const jive::bitcompare_op*>(&op));
 
-	static std::unordered_map<std::type_index, llvm::CmpInst::Predicate> map({
-	  {typeid(jive::biteq_op), llvm::CmpInst::ICMP_EQ}
-	, {typeid(jive::bitne_op), llvm::CmpInst::ICMP_NE}
-	, {typeid(jive::bitugt_op), llvm::CmpInst::ICMP_UGT}
-	, {typeid(jive::bituge_op), llvm::CmpInst::ICMP_UGE}
-	, {typeid(jive::bitult_op), llvm::CmpInst::ICMP_ULT}
-	, {typeid(jive::bitule_op), llvm::CmpInst::ICMP_ULE}
-	, {typeid(jive::bitsgt_op), llvm::CmpInst::ICMP_SGT}
-	, {typeid(jive::bitsge_op), llvm::CmpInst::ICMP_SGE}
-	, {typeid(jive::bitslt_op), llvm::CmpInst::ICMP_SLT}
-	, {typeid(jive::bitsle_op), llvm::CmpInst::ICMP_SLE}
-	});
-
 	auto op1 = ctx.value(args[0]);
 	auto op2 = ctx.value(args[1]);
-	JLM_ASSERT(map.find(std::type_index(typeid(op))) != map.end());
-	return builder.CreateICmp(map[std::type_index(typeid(op))], op1, op2);
+	switch (get_opcode(op)) {
+		case opcode::biteq_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_EQ, op1, op2);
+		case opcode::bitne_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_NE, op1, op2);
+		case opcode::bitugt_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_UGT, op1, op2);
+		case opcode::bituge_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_UGE, op1, op2);
+		case opcode::bitult_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_ULT, op1, op2);
+		case opcode::bitule_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_ULE, op1, op2);
+		case opcode::bitsgt_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_SGT, op1, op2);
+		case opcode::bitsge_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_SGE, op1, op2);
+		case opcode::bitslt_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_SLT, op1, op2);
+		case opcode::bitsle_op:
+			return builder.CreateICmp(llvm::CmpInst::ICMP_SLE, op1, op2);
+		default:
+			JLM_UNREACHABLE("Unhandled comparison operation.");
+	}
 }
 
 static llvm::APInt
@@ -842,80 +863,141 @@ convert_operation(
 	llvm::IRBuilder<> & builder,
 	context & ctx)
 {
-	if (dynamic_cast<const jive::bitbinary_op*>(&op))
-		return convert_bitsbinary(op, arguments, builder, ctx);
-
-	if (dynamic_cast<const jive::bitcompare_op*>(&op))
-		return convert_bitscompare(op, arguments, builder, ctx);
-
-	static std::unordered_map<
-		std::type_index
-	, llvm::Value*(*)(
-			const jive::simple_op &,
-			const std::vector<const variable*> &,
-			llvm::IRBuilder<> &,
-			context & ctx)
-	> map({
-	  {typeid(jive::bitconstant_op), convert_bitconstant}
-	, {typeid(jive::ctlconstant_op), convert_ctlconstant}
-	, {std::type_index(typeid(jlm::fpconstant_op)), convert_fpconstant}
-	, {std::type_index(typeid(jlm::undef_constant_op)), convert_undef}
-	, {typeid(jive::match_op), convert_match}
-	, {std::type_index(typeid(jlm::assignment_op)), convert_assignment}
-	, {std::type_index(typeid(jlm::branch_op)), convert_branch}
-	, {std::type_index(typeid(jlm::phi_op)), convert_phi}
-	, {std::type_index(typeid(jlm::load_op)), convert_load}
-	, {std::type_index(typeid(jlm::store_op)), convert_store}
-	, {std::type_index(typeid(jlm::alloca_op)), convert_alloca}
-	, {typeid(jlm::getelementptr_op), convert_getelementptr}
-	, {typeid(ConstantDataArray), convert<ConstantDataArray>}
-	, {std::type_index(typeid(jlm::ptrcmp_op)), convert_ptrcmp}
-	, {std::type_index(typeid(jlm::fpcmp_op)), convert_fpcmp}
-	, {std::type_index(typeid(jlm::fpbin_op)), convert_fpbin}
-	, {std::type_index(typeid(jlm::valist_op)), convert_valist}
-	, {std::type_index(typeid(jlm::struct_constant_op)), convert_struct_constant}
-	, {std::type_index(typeid(jlm::ptr_constant_null_op)), convert_ptr_constant_null}
-	, {std::type_index(typeid(jlm::select_op)), convert_select}
-	, {typeid(ConstantArray), convert<ConstantArray>}
-	, {typeid(constant_aggregate_zero_op), convert_constant_aggregate_zero}
-	, {typeid(ctl2bits_op), convert_ctl2bits}
-	, {typeid(constantvector_op), convert_constantvector}
-	, {typeid(constant_data_vector_op), convert_constantdatavector}
-	, {typeid(extractelement_op), convert_extractelement}
-	, {typeid(shufflevector_op), convert_shufflevector}
-	, {typeid(insertelement_op), convert_insertelement}
-	, {typeid(vectorunary_op), convert_vectorunary}
-	, {typeid(vectorbinary_op), convert_vectorbinary}
-	, {typeid(vectorselect_op), convert<vectorselect_op>}
-	, {typeid(extractvalue_op), convert<extractvalue_op>}
-
-	, {typeid(call_op), convert_call}
-	, {typeid(malloc_op), convert<malloc_op>}
-	, {typeid(free_op), convert<free_op>}
-	, {typeid(Memcpy), convert<Memcpy>}
-
-	, {typeid(fpneg_op), convert_fpneg}
-
-	/* LLVM Cast Instructions */
-	/* FIXME: AddrSpaceCast instruction is not supported */
-	, {typeid(bitcast_op), convert_cast<llvm::Instruction::BitCast>}
-	, {typeid(fpext_op), convert_cast<llvm::Instruction::FPExt>}
-	, {typeid(fp2si_op), convert_cast<llvm::Instruction::FPToSI>}
-	, {typeid(fp2ui_op), convert_cast<llvm::Instruction::FPToUI>}
-	, {typeid(fptrunc_op), convert_cast<llvm::Instruction::FPTrunc>}
-	, {typeid(bits2ptr_op), convert_cast<llvm::Instruction::IntToPtr>}
-	, {typeid(ptr2bits_op), convert_cast<llvm::Instruction::PtrToInt>}
-	, {typeid(sext_op), convert_cast<llvm::Instruction::SExt>}
-	, {typeid(sitofp_op), convert_cast<llvm::Instruction::SIToFP>}
-	, {typeid(trunc_op), convert_cast<llvm::Instruction::Trunc>}
-	, {typeid(uitofp_op), convert_cast<llvm::Instruction::UIToFP>}
-	, {typeid(zext_op), convert_cast<llvm::Instruction::ZExt>}
-
-	, {typeid(memstatemux_op), convert<memstatemux_op>}
-	});
-
-	JLM_ASSERT(map.find(std::type_index(typeid(op))) != map.end());
-	return map[std::type_index(typeid(op))](op, arguments, builder, ctx);
+	switch (get_opcode(op)) {
+		case opcode::bitadd_op:
+		case opcode::bitand_op:
+		case opcode::bitashr_op:
+		case opcode::bitsub_op:
+		case opcode::bitudiv_op:
+		case opcode::bitsdiv_op:
+		case opcode::bitumod_op:
+		case opcode::bitsmod_op:
+		case opcode::bitshl_op:
+		case opcode::bitshr_op:
+		case opcode::bitor_op:
+		case opcode::bitxor_op:
+		case opcode::bitmul_op:
+			return convert_bitsbinary(op, arguments, builder, ctx);
+		case opcode::biteq_op:
+		case opcode::bitne_op:
+		case opcode::bitugt_op:
+		case opcode::bituge_op:
+		case opcode::bitult_op:
+		case opcode::bitule_op:
+		case opcode::bitsgt_op:
+		case opcode::bitsge_op:
+		case opcode::bitslt_op:
+		case opcode::bitsle_op:
+			return convert_bitscompare(op, arguments, builder, ctx);
+		case opcode::bitconstant_op:
+			return convert_bitconstant(op, arguments, builder, ctx);
+		case opcode::ctlconstant_op:
+			return convert_ctlconstant(op, arguments, builder, ctx);
+		case opcode::fpconstant_op:
+			return convert_fpconstant(op, arguments, builder, ctx);
+		case opcode::undef_constant_op:
+			return convert_undef(op, arguments, builder, ctx);
+		case opcode::match_op:
+			return convert_match(op, arguments, builder, ctx);
+		case opcode::assignment_op:
+			return convert_assignment(op, arguments, builder, ctx);
+		case opcode::branch_op:
+			return convert_branch(op, arguments, builder, ctx);
+		case opcode::phi_op:
+			return convert_phi(op, arguments, builder, ctx);
+		case opcode::load_op:
+			return convert_load(op, arguments, builder, ctx);
+		case opcode::store_op:
+			return convert_store(op, arguments, builder, ctx);
+		case opcode::alloca_op:
+			return convert_alloca(op, arguments, builder, ctx);
+		case opcode::getelementptr_op:
+			return convert_getelementptr(op, arguments, builder, ctx);
+		case opcode::ConstantDataArray:
+			return convert<ConstantDataArray>(op, arguments, builder, ctx);
+		case opcode::ptrcmp_op:
+			return convert_ptrcmp(op, arguments, builder, ctx);
+		case opcode::fpcmp_op:
+			return convert_fpcmp(op, arguments, builder, ctx);
+		case opcode::fpbin_op:
+			return convert_fpbin(op, arguments, builder, ctx);
+		case opcode::valist_op:
+			return convert_valist(op, arguments, builder, ctx);
+		case opcode::struct_constant_op:
+			return convert_struct_constant(op, arguments, builder, ctx);
+		case opcode::ptr_constant_null_op:
+			return convert_ptr_constant_null(op, arguments, builder, ctx);
+		case opcode::select_op:
+			return convert_select(op, arguments, builder, ctx);
+		case opcode::ConstantArray:
+			return convert<ConstantArray>(op, arguments, builder, ctx);
+		case opcode::constant_aggregate_zero_op:
+			return convert_constant_aggregate_zero(op, arguments, builder, ctx);
+		case opcode::ctl2bits_op:
+			return convert_ctl2bits(op, arguments, builder, ctx);
+		case opcode::constantvector_op:
+			return convert_constantvector(op, arguments, builder, ctx);
+		case opcode::constant_data_vector_op:
+			return convert_constantdatavector(op, arguments, builder, ctx);
+		case opcode::extractelement_op:
+			return convert_extractelement(op, arguments, builder, ctx);
+		case opcode::shufflevector_op:
+			return convert_shufflevector(op, arguments, builder, ctx);
+		case opcode::insertelement_op:
+			return convert_insertelement(op, arguments, builder, ctx);
+		case opcode::vectorunary_op:
+			return convert_vectorunary(op, arguments, builder, ctx);
+		case opcode::vectorbinary_op:
+			return convert_vectorbinary(op, arguments, builder, ctx);
+		case opcode::vectorselect_op:
+			return convert<vectorselect_op>(op, arguments, builder, ctx);
+		case opcode::extractvalue_op:
+			return convert<extractvalue_op>(op, arguments, builder, ctx);
+
+		case opcode::call_op:
+			return convert_call(op, arguments, builder, ctx);
+		case opcode::malloc_op:
+			return convert<malloc_op>(op, arguments, builder, ctx);
+		case opcode::free_op:
+			return convert<free_op>(op, arguments, builder, ctx);
+		case opcode::Memcpy:
+			return convert<Memcpy>(op, arguments, builder, ctx);
+
+		case opcode::fpneg_op:
+			return convert_fpneg(op, arguments, builder, ctx);
+
+		/* LLVM Cast Instructions */
+		/* FIXME: AddrSpaceCast instruction is not supported */
+		case opcode::bitcast_op:
+			return convert_cast<llvm::Instruction::BitCast>(op, arguments, builder, ctx);
+		case opcode::fpext_op:
+			return convert_cast<llvm::Instruction::FPExt>(op, arguments, builder, ctx);
+		case opcode::fp2si_op:
+			return convert_cast<llvm::Instruction::FPToSI>(op, arguments, builder, ctx);
+		case opcode::fp2ui_op:
+			return convert_cast<llvm::Instruction::FPToUI>(op, arguments, builder, ctx);
+		case opcode::fptrunc_op:
+			return convert_cast<llvm::Instruction::FPTrunc>(op, arguments, builder, ctx);
+		case opcode::bits2ptr_op:
+			return convert_cast<llvm::Instruction::IntToPtr>(op, arguments, builder, ctx);
+		case opcode::ptr2bits_op:
+			return convert_cast<llvm::Instruction::PtrToInt>(op, arguments, builder, ctx);
+		case opcode::sext_op:
+			return convert_cast<llvm::Instruction::SExt>(op, arguments, builder, ctx);
+		case opcode::sitofp_op:
+			return convert_cast<llvm::Instruction::SIToFP>(op, arguments, builder, ctx);
+		case opcode::trunc_op:
+			return convert_cast<llvm::Instruction::Trunc>(op, arguments, builder, ctx);
+		case opcode::uitofp_op:
+			return convert_cast<llvm::Instruction::UIToFP>(op, arguments, builder, ctx);
+		case opcode::zext_op:
+			return convert_cast<llvm::Instruction::ZExt>(op, arguments, builder, ctx);
+
+		case opcode::memstatemux_op:
+			return convert<memstatemux_op>(op, arguments, builder, ctx);
+		default:
+			JLM_UNREACHABLE("Unhandled operation.");
+	}
 }
 
 void
@@ -17,6 +17,7 @@
 #include <jlm/backend/llvm/jlm2llvm/instruction.hpp>
 #include <jlm/backend/llvm/jlm2llvm/jlm2llvm.hpp>
 #include <jlm/backend/llvm/jlm2llvm/type.hpp>
+#include <jlm/util/parallel.hpp>
 
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/IRBuilder.h>
@@ -295,11 +296,28 @@ convert_attributes(const jlm::function_node & f, context & ctx)
 	return llvm::AttributeList::get(llvmctx, fctset, retset, argsets);
 }
 
-static inline void
-convert_cfg(jlm::cfg & cfg, llvm::Function & f, context & ctx)
+/*
+	Prepares \p cfg for its conversion and returns the order in which its nodes are emitted. The
+	preparation does not access any LLVM state and can therefore run concurrently for several
+	CFGs.
+*/
+static std::vector<cfg_node*>
+prepare_cfg(jlm::cfg & cfg)
 {
 	JLM_ASSERT(is_closed(cfg));
 
+	straighten(cfg);
+	return breadth_first(cfg);
+}
+
+static inline void
+convert_cfg(
+	const jlm::cfg & cfg,
+	const std::vector<cfg_node*> & nodes,
+	llvm::Function & f,
+	context & ctx)
+{
+
 	auto add_arguments = [](const jlm::cfg & cfg, llvm::Function & f, context & ctx)
 	{
 		size_t n = 0;
@@ -309,9 +327,6 @@ convert_cfg(jlm::cfg & cfg, llvm::Function & f, context & ctx)
 		}
 	};
 
-	straighten(cfg);
-	auto nodes = breadth_first(cfg);
-
 	/* create basic blocks */
 	for (const auto & node : nodes) {
 		if (node == cfg.entry() || node == cfg.exit())
@@ -370,10 +385,12 @@ convert_cfg(jlm::cfg & cfg, llvm::Function & f, context & ctx)
 }
 
 static inline void
-convert_function(const jlm::function_node & node, context & ctx)
+convert_function(
+	const jlm::function_node & node,
+	const std::vector<cfg_node*> & nodes,
+	context & ctx)
 {
-	if (!node.cfg())
-		return;
+	JLM_ASSERT(node.cfg());
 
 	auto & im = ctx.module();
 	auto f = llvm::cast<llvm::Function>(ctx.value(im.variable(&node)));
@@ -381,7 +398,7 @@ convert_function(const jlm::function_node & node, context & ctx)
 	auto attributes = convert_attributes(node, ctx);
 	f->setAttributes(attributes);
 
-	convert_cfg(*node.cfg(), *f, ctx);
+	convert_cfg(*node.cfg(), nodes, *f, ctx);
 }
 
 static void
@@ -446,15 +463,26 @@ convert_ipgraph(const jlm::ipgraph & clg, context & ctx)
 			JLM_ASSERT(0);
 	}
 
-	/* convert all nodes */
+	/* convert all data nodes */
+	std::vector<const function_node*> functions;
 	for (const auto & node : jm.ipgraph()) {
 		if (auto n = dynamic_cast<const data_node*>(&node)) {
 			convert_data_node(*n, ctx);
 		} else if (auto n = dynamic_cast<const function_node*>(&node)) {
-			convert_function(*n, ctx);
+			if (n->cfg())
+				functions.push_back(n);
 		} else
 			JLM_ASSERT(0);
 	}
+
+	/*
+		Convert all functions. An LLVM context is not thread-safe, so the CFGs are prepared in
+		parallel and the functions are emitted serially in their original order.
+	*/
+	std::vector<std::vector<cfg_node*>> nodes(functions.size());
+	parallel_pipeline(functions.size(),
+		[&](size_t n){ nodes[n] = prepare_cfg(*functions[n]->cfg()); },
+		[&](size_t n){ convert_function(*functions[n], nodes[n], ctx); nodes[n].clear(); });
 }
 
 std::unique_ptr<llvm::Module>
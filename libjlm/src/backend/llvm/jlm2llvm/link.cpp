@@ -0,0 +1,43 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/backend/llvm/jlm2llvm/jlm2llvm.hpp>
+
+#include <llvm/IR/Module.h>
+#include <llvm/Linker/Linker.h>
+
+#include <vector>
+
+namespace jlm {
+namespace jlm2llvm {
+
+void
+link(llvm::Module & dst, std::unique_ptr<llvm::Module> src)
+{
+	/*
+		The definitions in dst with local linkage are made external for the duration of the
+		linking, as the linker would otherwise not resolve the declarations in src to them.
+	*/
+	std::vector<std::pair<llvm::GlobalValue*, llvm::GlobalValue::LinkageTypes>> locals;
+	for (auto & gv : src->global_values()) {
+		if (!gv.isDeclaration())
+			continue;
+
+		auto definition = dst.getNamedValue(gv.getName());
+		if (definition && definition->hasLocalLinkage()) {
+			locals.push_back({definition, definition->getLinkage()});
+			definition->setLinkage(llvm::GlobalValue::ExternalLinkage);
+		}
+	}
+
+	if (llvm::Linker::linkModules(dst, std::move(src)))
+		throw jlm::error("Linking of modules failed.");
+
+	for (auto & local : locals)
+		local.first->setLinkage(local.second);
+}
+
+}}
@@ -18,6 +18,7 @@
 #include <jlm/ir/tac.hpp>
 #include <jlm/backend/llvm/rvsdg2jlm/context.hpp>
 #include <jlm/backend/llvm/rvsdg2jlm/rvsdg2jlm.hpp>
+#include <jlm/util/parallel.hpp>
 #include <jlm/util/stats.hpp>
 #include <jlm/util/time.hpp>
 
@@ -40,7 +41,7 @@ public:
 	void
 	start(const jive::graph & graph) noexcept
 	{
-		nnodes_ = jive::nnodes(graph.root());
+		nnodes_ = jlm::nnodes(graph);
 		timer_.start();
 	}
 
@@ -127,7 +128,7 @@ convert_region(jive::region & region, context & ctx)
 	ctx.lpbb()->add_outedge(entry);
 	ctx.set_lpbb(entry);
 
-	for (const auto & node : jive::topdown_traverser(&region))
+	for (const auto & node : ctx.schedule(region))
 		convert_node(*node, ctx);
 
 	auto exit = basic_block::create(*ctx.cfg());
@@ -168,7 +169,7 @@ create_cfg(const lambda::node & lambda, context & ctx)
 	ctx.set_lpbb(nullptr);
 	ctx.set_cfg(nullptr);
 
-	straighten(*cfg);
+	thread_branches(*cfg);
 	JLM_ASSERT(is_closed(*cfg));
 	return cfg;
 }
@@ -414,7 +415,7 @@ convert_lambda_node(const jive::node & node, context & ctx)
 		lambda->attributes());
 	auto v = module.create_variable(f);
 
-	f->add_cfg(create_cfg(*lambda, ctx));
+	ctx.defer(*lambda, f);
 	ctx.insert(node.output(0), v);
 }
 
@@ -459,7 +460,7 @@ convert_phi_node(const jive::node & node, context & ctx)
 
 		if (auto lambda = dynamic_cast<const lambda::node*>(node)) {
 			auto v = static_cast<const fctvariable*>(ctx.variable(subregion->argument(n)));
-			v->function()->add_cfg(create_cfg(*lambda, ctx));
+			ctx.defer(*lambda, v->function());
 			ctx.insert(node->output(0), v);
 		} else {
 			JLM_ASSERT(is<delta::operation>(node));
@@ -498,25 +499,21 @@ convert_delta_node(const jive::node & node, context & ctx)
 static inline void
 convert_node(const jive::node & node, context & ctx)
 {
-	static std::unordered_map<
-	  std::type_index
-	, std::function<void(const jive::node & node, context & ctx)
-	>> map({
-	  {typeid(lambda::operation), convert_lambda_node}
-	, {std::type_index(typeid(jive::gamma_op)), convert_gamma_node}
-	, {std::type_index(typeid(jive::theta_op)), convert_theta_node}
-	, {typeid(jive::phi::operation), convert_phi_node}
-	, {typeid(delta::operation), convert_delta_node}
-	});
-
-	if (dynamic_cast<const jive::simple_op*>(&node.operation())) {
-		convert_simple_node(node, ctx);
-		return;
+	switch (get_opcode(node.operation())) {
+		case opcode::lambda:
+			return convert_lambda_node(node, ctx);
+		case opcode::gamma_op:
+			return convert_gamma_node(node, ctx);
+		case opcode::theta_op:
+			return convert_theta_node(node, ctx);
+		case opcode::phi:
+			return convert_phi_node(node, ctx);
+		case opcode::delta:
+			return convert_delta_node(node, ctx);
+		default:
+			JLM_ASSERT(dynamic_cast<const jive::simple_op*>(&node.operation()));
+			return convert_simple_node(node, ctx);
 	}
-
-	auto & op = node.operation();
-	JLM_ASSERT(map.find(typeid(op)) != map.end());
-	map[typeid(op)](node, ctx);
 }
 
 static void
@@ -526,6 +523,51 @@ convert_nodes(const jive::graph & graph, context & ctx)
 		convert_node(*node, ctx);
 }
 
+static void
+precompute_schedules(jive::region & region, context & ctx)
+{
+	ctx.precompute_schedule(region);
+	for (auto & node : region.nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				precompute_schedules(*structnode->subregion(n), ctx);
+		}
+	}
+}
+
+/*
+	Constructs the CFGs of all deferred lambdas in parallel. Every lambda is converted with a
+	private context that only contains its context variables and the precomputed schedules of its
+	regions, such that the threads neither share mutable state nor traverse the RVSDG.
+*/
+static void
+convert_lambdas(context & ctx)
+{
+	auto & lambdas = ctx.deferred();
+
+	std::vector<std::unique_ptr<context>> contexts;
+	for (const auto & lambda : lambdas) {
+		auto lctx = std::make_unique<context>(ctx.module(), ctx.mode());
+		for (const auto & cv : lambda.first->ctxvars()) {
+			if (!lctx->contains(cv.origin()))
+				lctx->insert(cv.origin(), ctx.variable(cv.origin()));
+		}
+
+		precompute_schedules(*lambda.first->subregion(), *lctx);
+		contexts.push_back(std::move(lctx));
+	}
+
+	std::vector<std::unique_ptr<jlm::cfg>> cfgs(lambdas.size());
+	parallel_for(lambdas.size(), [&](size_t n)
+	{
+		cfgs[n] = create_cfg(*lambdas[n].first, *contexts[n]);
+		contexts[n].reset();
+	});
+
+	for (size_t n = 0; n < lambdas.size(); n++)
+		lambdas[n].second->add_cfg(std::move(cfgs[n]));
+}
+
 static void
 convert_imports(const jive::graph & graph, ipgraph_module & im, context & ctx)
 {
@@ -550,28 +592,33 @@ convert_imports(const jive::graph & graph, ipgraph_module & im, context & ctx)
 }
 
 static std::unique_ptr<ipgraph_module>
-convert_rvsdg(const rvsdg_module & rm)
+convert_rvsdg(const rvsdg_module & rm, schedulingmode mode)
 {
 	auto im = ipgraph_module::create(rm.source_filename(), rm.target_triple(), rm.data_layout());
 
-	context ctx(*im);
+	context ctx(*im, mode);
 	convert_imports(*rm.graph(), *im, ctx);
 	convert_nodes(*rm.graph(), ctx);
+	convert_lambdas(ctx);
 
 	return im;
 }
 
 std::unique_ptr<ipgraph_module>
-rvsdg2jlm(const rvsdg_module & rm, const stats_descriptor & sd)
+rvsdg2jlm(
+	const rvsdg_module & rm,
+	const stats_descriptor & sd,
+	schedulingmode mode)
 {
 	rvsdg_destruction_stat stat(rm.source_filename());
 
 	stat.start(*rm.graph());
-	auto im = convert_rvsdg(rm);
-	stat.end(*im);
+	auto im = convert_rvsdg(rm, mode);
 
-	if (sd.print_rvsdg_destruction)
+	if (sd.print_rvsdg_destruction) {
+		stat.end(*im);
 		sd.print_stat(stat);
+	}
 
 	return im;
 }
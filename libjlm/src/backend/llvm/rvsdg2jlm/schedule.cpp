@@ -0,0 +1,257 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/types/bitstring/arithmetic.hpp>
+#include <jive/rvsdg/region.hpp>
+#include <jive/rvsdg/structural-node.hpp>
+#include <jive/rvsdg/traverser.hpp>
+
+#include <jlm/common.hpp>
+#include <jlm/backend/llvm/rvsdg2jlm/schedule.hpp>
+#include <jlm/ir/operators.hpp>
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace jlm {
+namespace rvsdg2jlm {
+
+/*
+	Returns the distinct nodes that produce the operands of \p node.
+*/
+static std::vector<jive::node*>
+producers(const jive::node & node)
+{
+	std::vector<jive::node*> nodes;
+	for (size_t n = 0; n < node.ninputs(); n++) {
+		auto producer = jive::node_output::node(node.input(n)->origin());
+		if (producer && std::find(nodes.begin(), nodes.end(), producer) == nodes.end())
+			nodes.push_back(producer);
+	}
+
+	return nodes;
+}
+
+/* top-down scheduling */
+
+static std::vector<jive::node*>
+schedule_topdown(jive::region & region)
+{
+	std::vector<jive::node*> nodes;
+	for (const auto & node : jive::topdown_traverser(&region))
+		nodes.push_back(node);
+
+	return nodes;
+}
+
+/* register pressure scheduling */
+
+static std::vector<jive::node*>
+schedule_pressure(jive::region & region)
+{
+	auto topdown = schedule_topdown(region);
+
+	/*
+		Compute the Sethi-Ullman labels, i.e., the number of registers required to evaluate a node
+		with all its operands. The top-down order ensures that all producers are labeled first.
+	*/
+	std::unordered_map<const jive::node*, size_t> index, labels;
+	for (size_t i = 0; i < topdown.size(); i++) {
+		auto node = topdown[i];
+		std::vector<size_t> operands;
+		for (const auto & producer : producers(*node))
+			operands.push_back(labels[producer]);
+		std::sort(operands.begin(), operands.end(), std::greater<size_t>());
+
+		size_t label = 1;
+		for (size_t n = 0; n < operands.size(); n++)
+			label = std::max(label, operands[n] + n);
+
+		index[node] = i;
+		labels[node] = label;
+	}
+
+	std::vector<jive::node*> schedule;
+	std::unordered_set<const jive::node*> scheduled;
+	auto emit = [&](jive::node * root)
+	{
+		std::vector<std::pair<jive::node*, bool>> stack({{root, false}});
+		while (!stack.empty()) {
+			auto node = stack.back().first;
+			auto expanded = stack.back().second;
+			stack.pop_back();
+
+			if (scheduled.find(node) != scheduled.end())
+				continue;
+
+			if (expanded) {
+				scheduled.insert(node);
+				schedule.push_back(node);
+				continue;
+			}
+
+			/*
+				The operands are pushed in ascending label order, such that the operand with the
+				highest label is evaluated first.
+			*/
+			auto operands = producers(*node);
+			std::sort(operands.begin(), operands.end(), [&](const jive::node * n1, const jive::node * n2)
+			{
+				if (labels[n1] != labels[n2])
+					return labels[n1] < labels[n2];
+
+				return index[n1] > index[n2];
+			});
+
+			stack.push_back({node, true});
+			for (const auto & operand : operands)
+				stack.push_back({operand, false});
+		}
+	};
+
+	for (size_t n = 0; n < region.nresults(); n++) {
+		if (auto node = jive::node_output::node(region.result(n)->origin()))
+			emit(node);
+	}
+
+	/*
+		Schedule the remaining nodes, i.e., nodes that do not contribute to the region's results.
+	*/
+	for (const auto & node : topdown)
+		emit(node);
+
+	return schedule;
+}
+
+/* latency scheduling */
+
+/*
+	The estimate of a structural node is the number of nodes in its subregions, including the
+	nodes of nested regions. It is computed from the memoized estimates of the nested structural
+	nodes, which are exactly one plus the number of their nested nodes.
+*/
+size_t
+latencymap::latency(const jive::node & node)
+{
+	auto it = latencies_.find(&node);
+	if (it != latencies_.end())
+		return it->second;
+
+	size_t latency = 1;
+	if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+		for (size_t n = 0; n < structnode->nsubregions(); n++) {
+			for (const auto & subnode : structnode->subregion(n)->nodes) {
+				if (dynamic_cast<const jive::structural_node*>(&subnode))
+					latency += this->latency(subnode);
+				else
+					latency += 1;
+			}
+		}
+
+		latencies_[&node] = latency;
+		return latency;
+	}
+
+	auto & op = node.operation();
+	if (is<call_op>(op))
+		latency = 20;
+	else if (is<jive::bitsdiv_op>(op) || is<jive::bitudiv_op>(op)
+	|| is<jive::bitsmod_op>(op) || is<jive::bitumod_op>(op))
+		latency = 20;
+	else if (is<load_op>(op) || is<fpbin_op>(op))
+		latency = 4;
+	else if (is<jive::bitmul_op>(op))
+		latency = 3;
+
+	latencies_[&node] = latency;
+	return latency;
+}
+
+static std::vector<jive::node*>
+schedule_latency(jive::region & region, latencymap & latencies)
+{
+	auto nodes = schedule_topdown(region);
+
+	std::unordered_map<const jive::node*, size_t> index;
+	for (size_t n = 0; n < nodes.size(); n++)
+		index[nodes[n]] = n;
+
+	std::vector<size_t> npredecessors(nodes.size(), 0);
+	std::vector<std::vector<size_t>> successors(nodes.size());
+	for (size_t n = 0; n < nodes.size(); n++) {
+		for (const auto & producer : producers(*nodes[n])) {
+			successors[index[producer]].push_back(n);
+			npredecessors[n]++;
+		}
+	}
+
+	/*
+		The priority of a node is its latency distance to the region's results. The successors of a
+		node succeed it in the top-down order, and are therefore computed first.
+	*/
+	std::vector<size_t> priority(nodes.size(), 0);
+	for (size_t n = nodes.size(); n > 0; n--) {
+		size_t max = 0;
+		for (const auto & successor : successors[n-1])
+			max = std::max(max, priority[successor]);
+
+		priority[n-1] = latencies.latency(*nodes[n-1]) + max;
+	}
+
+	auto compare = [&](size_t n1, size_t n2)
+	{
+		if (priority[n1] != priority[n2])
+			return priority[n1] > priority[n2];
+
+		return n1 < n2;
+	};
+
+	std::set<size_t, decltype(compare)> ready(compare);
+	for (size_t n = 0; n < nodes.size(); n++) {
+		if (npredecessors[n] == 0)
+			ready.insert(n);
+	}
+
+	std::vector<jive::node*> schedule;
+	while (!ready.empty()) {
+		auto n = *ready.begin();
+		ready.erase(ready.begin());
+
+		schedule.push_back(nodes[n]);
+		for (const auto & successor : successors[n]) {
+			if (--npredecessors[successor] == 0)
+				ready.insert(successor);
+		}
+	}
+
+	JLM_ASSERT(schedule.size() == nodes.size());
+	return schedule;
+}
+
+std::vector<jive::node*>
+schedule(jive::region & region, schedulingmode mode, latencymap & latencies)
+{
+	switch (mode) {
+		case schedulingmode::topdown:
+			return schedule_topdown(region);
+		case schedulingmode::pressure:
+			return schedule_pressure(region);
+		case schedulingmode::latency:
+			return schedule_latency(region, latencies);
+	}
+
+	JLM_UNREACHABLE("Unhandled scheduling mode.");
+}
+
+std::vector<jive::node*>
+schedule(jive::region & region, schedulingmode mode)
+{
+	latencymap latencies;
+	return schedule(region, mode, latencies);
+}
+
+}}
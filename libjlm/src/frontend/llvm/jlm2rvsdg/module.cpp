@@ -221,17 +221,29 @@ public:
 	{}
 
 	void
-	start(const ipgraph_module & im) noexcept
+	start(size_t ntacs) noexcept
 	{
-		ntacs_ = jlm::ntacs(im);
+		ntacs_ = ntacs;
 		timer_.start();
 	}
 
+	void
+	start(const ipgraph_module & im) noexcept
+	{
+		start(jlm::ntacs(im));
+	}
+
+	void
+	add_ntacs(size_t ntacs) noexcept
+	{
+		ntacs_ += ntacs;
+	}
+
 	void
 	end(const jive::graph & graph) noexcept
 	{
 		timer_.stop();
-		nnodes_ = jive::nnodes(graph.root());
+		nnodes_ = jlm::nnodes(graph);
 	}
 
 	virtual std::string
@@ -386,18 +398,16 @@ convert_branch(const jlm::tac & tac, jive::region * region, jlm::vmap & vmap)
 static void
 convert_tac(const jlm::tac & tac, jive::region * region, jlm::vmap & vmap)
 {
-	static std::unordered_map<
-		std::type_index,
-		std::function<void(const jlm::tac&, jive::region*, jlm::vmap&)>
-	> map({
-	  {std::type_index(typeid(assignment_op)), convert_assignment}
-	, {std::type_index(typeid(select_op)), convert_select}
-	, {std::type_index(typeid(branch_op)), convert_branch}
-	});
-
-	auto & op = tac.operation();
-	if (map.find(typeid(op)) != map.end())
-		return map[typeid(op)](tac, region, vmap);
+	switch (get_opcode(tac.operation())) {
+		case opcode::assignment_op:
+			return convert_assignment(tac, region, vmap);
+		case opcode::select_op:
+			return convert_select(tac, region, vmap);
+		case opcode::branch_op:
+			return convert_branch(tac, region, vmap);
+		default:
+			break;
+	}
 
 	std::vector<jive::output*> operands;
 	for (size_t n = 0; n < tac.noperands(); n++)
@@ -418,14 +428,6 @@ convert_basic_block(const taclist & bb, jive::region * region, jlm::vmap & vmap)
 		convert_tac(*tac, region, vmap);
 }
 
-static void
-convert_node(
-	const aggnode & node,
-	const demandmap & dm,
-	const jlm::function_node & function,
-	lambda::node * lambda,
-	scoped_vmap & svmap);
-
 static void
 convert_entry_node(
 	const aggnode & node,
@@ -498,28 +500,38 @@ convert_block_node(
 	convert_basic_block(bb, svmap.region(), svmap.vmap());
 }
 
-static void
-convert_linear_node(
-	const aggnode & node,
-	const demandmap & dm,
-	const jlm::function_node & function,
-	lambda::node * lambda,
-	scoped_vmap & svmap)
-{
-	JLM_ASSERT(is<linearaggnode>(&node));
+/*
+	A frame of the aggregation tree conversion. It records the number of children of a linear,
+	branch, or loop node that were already converted, as well as the state that is required to
+	finish the conversion of the node once all its children are converted.
+*/
+struct convframe {
+	inline
+	convframe(const aggnode * n)
+	: node(n)
+	, nconverted(0)
+	, gamma(nullptr)
+	, theta(nullptr)
+	{}
 
-	for (const auto & child : node)
-		convert_node(child, dm, function, lambda, svmap);
-}
+	const aggnode * node;
+	size_t nconverted;
+
+	jive::gamma_node * gamma;
+	std::unordered_map<const variable*, jive::gamma_input*> evmap;
+	std::unordered_map<const variable*, std::vector<jive::output*>> xvmap;
+
+	jive::theta_node * theta;
+	std::unordered_map<const variable*, jive::theta_output*> lvmap;
+};
 
 static void
-convert_branch_node(
-	const aggnode & node,
+enter_branch_node(
+	convframe & frame,
 	const demandmap & dm,
-	const jlm::function_node & function,
-	lambda::node * lambda,
 	scoped_vmap & svmap)
 {
+	auto & node = *frame.node;
 	JLM_ASSERT(is<branchaggnode>(&node));
 	JLM_ASSERT(is<linearaggnode>(node.parent()));
 
@@ -530,57 +542,72 @@ convert_branch_node(
 
 	JLM_ASSERT(is<branch_op>(sb.last()->operation()));
 	auto predicate = svmap.vmap().lookup(sb.last()->operand(0));
-	auto gamma = jive::gamma_node::create(predicate, node.nchildren());
+	frame.gamma = jive::gamma_node::create(predicate, node.nchildren());
 
 	/* add entry variables */
 	auto & ds = dm.at(&node);
-	std::unordered_map<const variable*, jive::gamma_input*> evmap;
 	for (const auto & v : ds->top)
-		evmap[v] = gamma->add_entryvar(svmap.vmap().lookup(v));
+		frame.evmap[v] = frame.gamma->add_entryvar(svmap.vmap().lookup(v));
 
-	/* convert branch cases */
-	std::unordered_map<const variable*, std::vector<jive::output*>> xvmap;
-	JLM_ASSERT(gamma->nsubregions() == node.nchildren());
-	for (size_t n = 0; n < gamma->nsubregions(); n++) {
-		svmap.push_scope(gamma->subregion(n));
-		for (const auto & pair : evmap)
-			svmap.vmap().insert(pair.first, pair.second->argument(n));
+	JLM_ASSERT(frame.gamma->nsubregions() == node.nchildren());
+}
 
-		convert_node(*node.child(n), dm, function, lambda, svmap);
+static void
+enter_branch_case(
+	convframe & frame,
+	size_t n,
+	scoped_vmap & svmap)
+{
+	svmap.push_scope(frame.gamma->subregion(n));
+	for (const auto & pair : frame.evmap)
+		svmap.vmap().insert(pair.first, pair.second->argument(n));
+}
 
-		for (const auto & v : ds->bottom)
-			xvmap[v].push_back(svmap.vmap().lookup(v));
-		svmap.pop_scope();
-	}
+static void
+leave_branch_case(
+	convframe & frame,
+	const demandmap & dm,
+	scoped_vmap & svmap)
+{
+	auto & ds = dm.at(frame.node);
+	for (const auto & v : ds->bottom)
+		frame.xvmap[v].push_back(svmap.vmap().lookup(v));
+	svmap.pop_scope();
+}
 
+static void
+leave_branch_node(
+	convframe & frame,
+	const demandmap & dm,
+	scoped_vmap & svmap)
+{
 	/* add exit variables */
+	auto & ds = dm.at(frame.node);
 	for (const auto & v : ds->bottom) {
-		JLM_ASSERT(xvmap.find(v) != xvmap.end());
-		svmap.vmap().insert(v, gamma->add_exitvar(xvmap[v]));
+		JLM_ASSERT(frame.xvmap.find(v) != frame.xvmap.end());
+		svmap.vmap().insert(v, frame.gamma->add_exitvar(frame.xvmap[v]));
 	}
 }
 
 static void
-convert_loop_node(
-	const aggnode & node,
+enter_loop_node(
+	convframe & frame,
 	const demandmap & dm,
-	const jlm::function_node & function,
-	lambda::node * lambda,
 	scoped_vmap & svmap)
 {
+	auto & node = *frame.node;
 	JIVE_DEBUG_ASSERT(is<loopaggnode>(&node));
 	auto parent = svmap.region();
 
-	auto theta = jive::theta_node::create(parent);
+	frame.theta = jive::theta_node::create(parent);
 
-	svmap.push_scope(theta->subregion());
+	svmap.push_scope(frame.theta->subregion());
 	auto & vmap = svmap.vmap();
 	auto & pvmap = svmap.vmap(svmap.nscopes()-2);
 
 	/* add loop variables */
 	auto ds = dm.at(&node).get();
 	JLM_ASSERT(ds->top == ds->bottom);
-	std::unordered_map<const variable*, jive::theta_output*> lvmap;
 	for (const auto & v : ds->top) {
 		jive::output * value = nullptr;
 		if (!pvmap.contains(v)) {
@@ -590,13 +617,24 @@ convert_loop_node(
 		} else {
 			value = pvmap.lookup(v);
 		}
-		lvmap[v] = theta->add_loopvar(value);
-		vmap.insert(v, lvmap[v]->argument());
+		frame.lvmap[v] = frame.theta->add_loopvar(value);
+		vmap.insert(v, frame.lvmap[v]->argument());
 	}
 
-	/* convert loop body */
 	JLM_ASSERT(node.nchildren() == 1);
-	convert_node(*node.child(0), dm, function, lambda, svmap);
+}
+
+static void
+leave_loop_node(
+	convframe & frame,
+	const demandmap & dm,
+	scoped_vmap & svmap)
+{
+	auto & node = *frame.node;
+	auto & lvmap = frame.lvmap;
+	auto & vmap = svmap.vmap();
+	auto & pvmap = svmap.vmap(svmap.nscopes()-2);
+	auto ds = dm.at(&node).get();
 
 	/* update loop variables */
 	for (const auto & v : ds->top) {
@@ -614,7 +652,7 @@ convert_loop_node(
 	auto predicate = bb.last()->operand(0);
 
 	/* update variable map */
-	theta->set_predicate(vmap.lookup(predicate));
+	frame.theta->set_predicate(vmap.lookup(predicate));
 	svmap.pop_scope();
 	for (const auto & v : ds->bottom) {
 		JLM_ASSERT(pvmap.contains(v));
@@ -622,31 +660,84 @@ convert_loop_node(
 	}
 }
 
+/*
+	Converts the aggregation tree rooted in \p root with an explicit stack of frames instead of
+	recursion, such that deeply nested control flow cannot exhaust the call stack.
+*/
 static void
 convert_node(
-	const aggnode & node,
+	const aggnode & root,
 	const demandmap & dm,
 	const jlm::function_node & function,
 	lambda::node * lambda,
 	scoped_vmap & svmap)
 {
-	static std::unordered_map<
-		std::type_index,
-		std::function<void(
-			const aggnode&,
-			const demandmap&,
-			const function_node&,
-			lambda::node*,
-			scoped_vmap&)
-		>
-	> map ({
-	  {typeid(entryaggnode), convert_entry_node}, {typeid(exitaggnode), convert_exit_node}
-	, {typeid(blockaggnode), convert_block_node}, {typeid(linearaggnode), convert_linear_node}
-	, {typeid(branchaggnode), convert_branch_node}, {typeid(loopaggnode), convert_loop_node}
-	});
+	std::vector<convframe> stack({convframe(&root)});
+	while (!stack.empty()) {
+		auto & frame = stack.back();
+		auto & node = *frame.node;
+
+		if (is<entryaggnode>(&node)) {
+			convert_entry_node(node, dm, function, lambda, svmap);
+			stack.pop_back();
+			continue;
+		}
 
-	JLM_ASSERT(map.find(typeid(node)) != map.end());
-	map[typeid(node)](node, dm, function, lambda, svmap);
+		if (is<exitaggnode>(&node)) {
+			convert_exit_node(node, dm, function, lambda, svmap);
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<blockaggnode>(&node)) {
+			convert_block_node(node, dm, function, lambda, svmap);
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<linearaggnode>(&node)) {
+			if (frame.nconverted < node.nchildren()) {
+				auto child = node.child(frame.nconverted++);
+				stack.emplace_back(child);
+				continue;
+			}
+
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<branchaggnode>(&node)) {
+			if (frame.gamma == nullptr)
+				enter_branch_node(frame, dm, svmap);
+			else
+				leave_branch_case(frame, dm, svmap);
+
+			if (frame.nconverted < node.nchildren()) {
+				enter_branch_case(frame, frame.nconverted, svmap);
+				auto child = node.child(frame.nconverted++);
+				stack.emplace_back(child);
+				continue;
+			}
+
+			leave_branch_node(frame, dm, svmap);
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<loopaggnode>(&node)) {
+			if (frame.theta == nullptr) {
+				enter_loop_node(frame, dm, svmap);
+				stack.emplace_back(node.child(0));
+				continue;
+			}
+
+			leave_loop_node(frame, dm, svmap);
+			stack.pop_back();
+			continue;
+		}
+
+		JLM_UNREACHABLE("Unhandled aggregation node type.");
+	}
 }
 
 static jive::output *
@@ -659,8 +750,7 @@ convert_cfg(
 	auto cfg = function.cfg();
 
 	destruct_ssa(*cfg);
-	straighten(*cfg);
-	purge(*cfg);
+	simplify(*cfg, true);
 
 	{
 		cfrstat stat(source_filename, function.name());
@@ -686,7 +776,8 @@ convert_cfg(
 	demandmap dm;
 	{
 		annotation_stat stat(source_filename, function.name());
-		stat.start(*root);
+		if (sd.print_annotation_time)
+			stat.start(*root);
 		dm = annotate(*root);
 		stat.end();
 		if (sd.print_annotation_time)
@@ -780,7 +871,8 @@ handle_scc(
 	const std::unordered_set<const jlm::ipgraph_node*> & scc,
 	jive::graph * graph,
 	scoped_vmap & svmap,
-	const stats_descriptor & sd)
+	const stats_descriptor & sd,
+	bool export_all = false)
 {
 	auto & m = svmap.module();
 
@@ -804,7 +896,7 @@ handle_scc(
 		auto v = m.variable(node);
 		JLM_ASSERT(v);
 		svmap.vmap().insert(v, output);
-		if (is_externally_visible(node->linkage()))
+		if (export_all || is_externally_visible(node->linkage()))
 			graph->add_export(output, {output->type(), v->name()});
 	} else {
 		jive::phi::builder pb;
@@ -849,14 +941,14 @@ handle_scc(
 			auto v = m.variable(node);
 			auto value = recvars[v];
 			svmap.vmap().insert(v, value);
-			if (is_externally_visible(node->linkage()))
+			if (export_all || is_externally_visible(node->linkage()))
 				graph->add_export(value, {value->type(), v->name()});
 		}
 	}
 }
 
 static std::unique_ptr<rvsdg_module>
-convert_module(const ipgraph_module & im, const stats_descriptor & sd)
+create_rvsdg_module(const ipgraph_module & im)
 {
 	auto rm = rvsdg_module::create(im.source_filename(), im.target_triple(), im.data_layout());
 	auto graph = rm->graph();
@@ -867,29 +959,129 @@ convert_module(const ipgraph_module & im, const stats_descriptor & sd)
 	/* FIXME: we currently cannot handle flattened_binary_op in jlm2llvm pass */
 	jive::binary_op::normal_form(graph)->set_flatten(false);
 
+	return rm;
+}
+
+std::unique_ptr<rvsdg_module>
+construct_rvsdg(
+	ipgraph_module & im,
+	const stats_descriptor & sd,
+	const std::function<void(function_node&)> & materialize,
+	const std::function<void(function_node&)> & release)
+{
+	source_filename = im.source_filename().to_str();
+
+	rvsdg_construction_stat stat(im.source_filename());
+
+	/*
+		The CFGs that are present at the start are counted by the statistics right away, while
+		materialized CFGs are counted as they are created.
+	*/
+	if (sd.print_rvsdg_construction)
+		stat.start(im);
+
+	auto rm = create_rvsdg_module(im);
+	auto graph = rm->graph();
 	scoped_vmap svmap(im, graph->root());
 
 	/* convert ipgraph nodes */
-	auto sccs = im.ipgraph().find_sccs();
-	for (const auto & scc : sccs)
-		handle_scc(scc, graph, svmap, sd);
+	for (const auto & scc : im.ipgraph().find_sccs()) {
+		for (const auto & node : scc) {
+			auto function = dynamic_cast<function_node*>(node);
+			if (!function || function->cfg())
+				continue;
+
+			materialize(*function);
+			if (sd.print_rvsdg_construction && function->cfg())
+				stat.add_ntacs(jlm::ntacs(*function->cfg()));
+		}
+
+		std::unordered_set<const ipgraph_node*> nodes(scc.begin(), scc.end());
+		handle_scc(nodes, graph, svmap, sd);
+
+		for (const auto & node : scc) {
+			if (auto function = dynamic_cast<function_node*>(node))
+				release(*function);
+		}
+	}
+
+	if (sd.print_rvsdg_construction) {
+		stat.end(*graph);
+		sd.print_stat(stat);
+	}
 
 	return rm;
 }
 
 std::unique_ptr<rvsdg_module>
-construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd)
+construct_rvsdg(
+	const ipgraph_module & im,
+	const std::unordered_set<const ipgraph_node*> & scc,
+	const stats_descriptor & sd)
 {
 	source_filename = im.source_filename().to_str();
 
 	rvsdg_construction_stat stat(im.source_filename());
 
-	stat.start(im);
-	auto rm = convert_module(im, sd);
-	stat.end(*rm->graph());
+	if (sd.print_rvsdg_construction) {
+		size_t ntacs = 0;
+		for (const auto & node : scc) {
+			auto function = dynamic_cast<const function_node*>(node);
+			if (function && function->cfg())
+				ntacs += jlm::ntacs(*function->cfg());
+		}
+
+		stat.start(ntacs);
+	}
+
+	auto rm = create_rvsdg_module(im);
+	auto graph = rm->graph();
+	scoped_vmap svmap(im, graph->root());
+
+	/* import all nodes of other SCCs the SCC depends on */
+	for (const auto & node : scc) {
+		for (const auto & dep : *node) {
+			auto v = im.variable(dep);
+			if (scc.find(dep) != scc.end() || svmap.vmap().contains(v))
+				continue;
+
+			jlm::impport port(dep->type(), dep->name(), linkage::external_linkage);
+			svmap.vmap().insert(v, graph->add_import(port));
+		}
+	}
+
+	handle_scc(scc, graph, svmap, sd, true);
+
+	if (sd.print_rvsdg_construction) {
+		stat.end(*graph);
+		sd.print_stat(stat);
+	}
+
+	return rm;
+}
+
+std::unique_ptr<rvsdg_module>
+construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd)
+{
+	source_filename = im.source_filename().to_str();
+
+	rvsdg_construction_stat stat(im.source_filename());
 
 	if (sd.print_rvsdg_construction)
+		stat.start(im);
+
+	auto rm = create_rvsdg_module(im);
+	auto graph = rm->graph();
+	scoped_vmap svmap(im, graph->root());
+
+	/* convert ipgraph nodes */
+	for (const auto & scc : im.ipgraph().find_sccs())
+		handle_scc(scc, graph, svmap, sd);
+
+	if (sd.print_rvsdg_construction) {
+		stat.end(*graph);
 		sd.print_stat(stat);
+	}
 
 	return rm;
 }
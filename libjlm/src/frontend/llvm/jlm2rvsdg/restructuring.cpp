@@ -14,7 +14,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -301,66 +300,133 @@ find_head_branch(jlm::cfg_node * start, jlm::cfg_node * end)
 	return start;
 }
 
-static std::unordered_set<jlm::cfg_node*>
-find_dominator_graph(const jlm::cfg_edge * edge)
-{
-	std::unordered_set<jlm::cfg_node*> nodes;
-	std::unordered_set<const jlm::cfg_edge*> edges({edge});
+/*
+	Computes the sets of nodes that are dominated by an edge for the continuation computations of a
+	branch restructuring. Nodes are densely numbered on first encounter, including the nodes that
+	are created during restructuring, and the per-node counters are reset lazily with a query stamp
+	instead of allocating fresh sets for every query.
+*/
+class dominance final {
+public:
+	dominance()
+	: query_(0)
+	{}
 
-	std::deque<jlm::cfg_node*> to_visit(1, edge->sink());
-	while (to_visit.size() != 0) {
-		jlm::cfg_node * node = to_visit.front(); to_visit.pop_front();
-		if (nodes.find(node) != nodes.end())
-			continue;
+	/*
+		Returns the nodes dominated by \p edge, i.e., the nodes that are only reachable through
+		\p edge. A node is dominated once all its in-edges originate from dominated nodes or are
+		\p edge itself.
+	*/
+	const std::vector<cfg_node*> &
+	dominated_nodes(const cfg_edge * edge)
+	{
+		query_++;
+		nodes_.clear();
 
-		bool accept = true;
-		for (auto & inedge : node->inedges()) {
-			if (edges.find(inedge) == edges.end()) {
-				accept = false;
-				break;
-			}
-		}
+		if (!accept(edge->sink()))
+			return nodes_;
+
+		std::vector<cfg_node*> worklist({edge->sink()});
+		while (!worklist.empty()) {
+			auto node = worklist.back();
+			worklist.pop_back();
+			nodes_.push_back(node);
 
-		if (accept) {
-			nodes.insert(node);
 			for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-				edges.insert(it.edge());
-				to_visit.push_back(it->sink());
+				if (accept(it->sink()))
+					worklist.push_back(it->sink());
 			}
 		}
+
+		return nodes_;
 	}
 
-	return nodes;
-}
+	/*
+		Returns true if \p node is part of the nodes returned by the last \ref dominated_nodes()
+		invocation.
+	*/
+	bool
+	contains(cfg_node * node)
+	{
+		return members_[index(node)] == query_;
+	}
+
+private:
+	size_t
+	index(cfg_node * node)
+	{
+		auto it = indices_.find(node);
+		if (it != indices_.end())
+			return it->second;
+
+		auto index = indices_.size();
+		indices_[node] = index;
+		counts_.push_back(0);
+		stamps_.push_back(0);
+		members_.push_back(0);
+		return index;
+	}
+
+	/*
+		Accounts for one more dominated in-edge of \p node. Returns true if all in-edges of \p node
+		are now dominated.
+	*/
+	bool
+	accept(cfg_node * node)
+	{
+		auto i = index(node);
+		if (stamps_[i] != query_) {
+			stamps_[i] = query_;
+			counts_[i] = 0;
+		}
+
+		if (++counts_[i] != node->ninedges())
+			return false;
+
+		members_[i] = query_;
+		return true;
+	}
+
+	size_t query_;
+	std::vector<cfg_node*> nodes_;
+	std::vector<size_t> counts_;
+	std::vector<size_t> stamps_;
+	std::vector<size_t> members_;
+	std::unordered_map<cfg_node*, size_t> indices_;
+};
 
 struct continuation {
-	std::unordered_set<jlm::cfg_node*> points;
-	std::unordered_map<jlm::cfg_edge*, std::unordered_set<jlm::cfg_edge*>> edges;
+	std::vector<jlm::cfg_node*> points;
+	std::vector<std::vector<jlm::cfg_edge*>> edges;
 };
 
 static inline continuation
-compute_continuation(jlm::cfg_node * hb)
+compute_continuation(jlm::cfg_node * hb, dominance & d)
 {
 	JLM_ASSERT(hb->noutedges() > 1);
 
-	std::unordered_map<jlm::cfg_edge*, std::unordered_set<jlm::cfg_node*>> dgraphs;
-	for (auto it = hb->begin_outedges(); it != hb->end_outedges(); it++)
-		dgraphs[it.edge()] = find_dominator_graph(it.edge());
-
 	continuation c;
+	c.edges.resize(hb->noutedges());
+	std::unordered_set<jlm::cfg_node*> points;
+	auto add_point = [&](jlm::cfg_node * point) {
+		if (points.insert(point).second)
+			c.points.push_back(point);
+	};
+
 	for (auto it = hb->begin_outedges(); it != hb->end_outedges(); it++) {
-		auto & dgraph = dgraphs[it.edge()];
+		auto & cedges = c.edges[it->index()];
+		auto & dgraph = d.dominated_nodes(it.edge());
 		if (dgraph.empty()) {
-			c.edges[it.edge()].insert(it.edge());
-			c.points.insert(it.edge()->sink());
+			cedges.push_back(it.edge());
+			add_point(it->sink());
 			continue;
 		}
 
 		for (const auto & node : dgraph) {
 			for (auto it2 = node->begin_outedges(); it2 != node->end_outedges(); it2++) {
-				if (dgraph.find(it2->sink()) == dgraph.end()) {
-					c.edges[it.edge()].insert(it2.edge());
-					c.points.insert(it2->sink());
+				if (!d.contains(it2->sink())) {
+					cedges.push_back(it2.edge());
+					add_point(it2->sink());
 				}
 			}
 		}
@@ -369,8 +435,18 @@ compute_continuation(jlm::cfg_node * hb)
 	return c;
 }
 
+typedef std::pair<jlm::cfg_node*, jlm::cfg_node*> sese;
+
+/*
+	Restructures the head branch of the region from \p entry to \p exit, and pushes the branch
+	subgraphs and the tail subgraph onto \p regions for subsequent restructuring.
+*/
 static inline void
-restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
+restructure_branches(
+	jlm::cfg_node * entry,
+	jlm::cfg_node * exit,
+	dominance & d,
+	std::vector<sese> & regions)
 {
 	auto & cfg = entry->cfg();
 
@@ -380,13 +456,14 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 	JLM_ASSERT(is<basic_block>(hb));
 	auto & hbb = *static_cast<basic_block*>(hb);
 
-	auto c = compute_continuation(hb);
+	auto c = compute_continuation(hb, d);
 	JLM_ASSERT(!c.points.empty());
 
+	std::vector<sese> subregions;
 	if (c.points.size() == 1) {
-		auto cpoint = *c.points.begin();
+		auto cpoint = c.points[0];
 		for (auto it = hb->begin_outedges(); it != hb->end_outedges(); it++) {
-			auto cedges = c.edges[it.edge()];
+			auto & cedges = c.edges[it->index()];
 
 			/* empty branch subgraph */
 			if (it->sink() == cpoint) {
@@ -396,9 +473,9 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 
 			/* only one continuation edge */
 			if (cedges.size() == 1) {
-				auto e = *cedges.begin();
+				auto e = cedges[0];
 				JLM_ASSERT(e != it.edge());
-				restructure_branches(it->sink(), e->source());
+				subregions.push_back({it->sink(), e->source()});
 				continue;
 			}
 
@@ -407,11 +484,12 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 			null->add_outedge(cpoint);
 			for (const auto & e : cedges)
 				e->divert(null);
-			restructure_branches(it->sink(), null);
+			subregions.push_back({it->sink(), null});
 		}
 
 		/* restructure tail subgraph */
-		restructure_branches(cpoint, exit);
+		subregions.push_back({cpoint, exit});
+		regions.insert(regions.end(), subregions.rbegin(), subregions.rend());
 		return;
 	}
 
@@ -427,7 +505,7 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 
 	/* restructure branch subgraphs */
 	for (auto it = hb->begin_outedges(); it != hb->end_outedges(); it++) {
-		auto cedges = c.edges[it.edge()];
+		auto & cedges = c.edges[it->index()];
 
 		auto null = basic_block::create(cfg);
 		null->add_outedge(cn);
@@ -438,11 +516,29 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 			e->divert(bb);
 		}
 
-		restructure_branches(it->sink(), null);
+		subregions.push_back({it->sink(), null});
 	}
 
 	/* restructure tail subgraph */
-	restructure_branches(cn, exit);
+	subregions.push_back({cn, exit});
+	regions.insert(regions.end(), subregions.rbegin(), subregions.rend());
+}
+
+/*
+	Restructures the branches of the region from \p entry to \p exit. The regions are processed
+	from an explicit work stack in the same order as a recursive descent into branch subgraphs
+	followed by the tail subgraph, but without a call depth that grows with the branch nesting.
+*/
+static inline void
+restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
+{
+	dominance d;
+	std::vector<sese> regions({{entry, exit}});
+	while (!regions.empty()) {
+		auto r = regions.back();
+		regions.pop_back();
+		restructure_branches(r.first, r.second, d, regions);
+	}
 }
 
 void
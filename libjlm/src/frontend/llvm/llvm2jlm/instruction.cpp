@@ -32,17 +32,24 @@
 
 namespace jlm {
 
+void
+add_dependency(ipgraph_node & node, const llvm::Value * v, const context & ctx)
+{
+	if (!ctx.has_value(v))
+		return;
+
+	if (auto callee = dynamic_cast<const fctvariable*>(ctx.lookup_value(v)))
+		node.add_dependency(callee->function());
+
+	if (auto data = dynamic_cast<const gblvalue*>(ctx.lookup_value(v)))
+		node.add_dependency(data->node());
+}
+
 const variable *
 convert_value(llvm::Value * v, tacsvector_t & tacs, context & ctx)
 {
-	auto node = ctx.node();
-	if (node && ctx.has_value(v)) {
-		if (auto callee = dynamic_cast<const fctvariable*>(ctx.lookup_value(v)))
-			node->add_dependency(callee->function());
-
-		if (auto data = dynamic_cast<const gblvalue*>(ctx.lookup_value(v)))
-			node->add_dependency(data->node());
-	}
+	if (auto node = ctx.node())
+		add_dependency(*node, v, ctx);
 
 	if (ctx.has_value(v))
 		return ctx.lookup_value(v);
@@ -344,8 +351,13 @@ convert_constant(
 	,	{llvm::Value::FunctionVal, convert_function}
 	});
 
+	/*
+		The conversion of constants creates LLVM constants and instructions, which mutates the LLVM
+		context. It is therefore serialized across concurrently converted function bodies.
+	*/
+	std::lock_guard<std::recursive_mutex> guard(ctx.llvm_mutex());
 	JLM_ASSERT(cmap.find(c->getValueID()) != cmap.end());
-	return cmap[c->getValueID()](c, tacs, ctx);
+	return cmap.at(c->getValueID())(c, tacs, ctx);
 }
 
 std::vector<std::unique_ptr<jlm::tac>>
@@ -471,10 +483,10 @@ convert_icmp_instruction(llvm::Instruction * instruction, tacsvector_t & tacs, c
 	if (t->isIntegerTy() || (t->isVectorTy() && t->getVectorElementType()->isIntegerTy())) {
 		auto it = t->isVectorTy() ? t->getVectorElementType() : t;
 		/* FIXME: This is inefficient. We return a unique ptr and then take copy it. */
-		binop = map[p](it->getIntegerBitWidth());
+		binop = map.at(p)(it->getIntegerBitWidth());
 	} else if (t->isPointerTy() || (t->isVectorTy() && t->getVectorElementType()->isPointerTy())) {
 		auto pt = llvm::cast<llvm::PointerType>(t->isVectorTy() ? t->getVectorElementType() : t);
-		binop = std::make_unique<ptrcmp_op>(*convert_type(pt, ctx), ptrmap[p]);
+		binop = std::make_unique<ptrcmp_op>(*convert_type(pt, ctx), ptrmap.at(p));
 	} else
 		JLM_ASSERT(0);
 
@@ -517,7 +529,7 @@ convert_fcmp_instruction(llvm::Instruction * instruction, tacsvector_t & tacs, c
 
 	JLM_ASSERT(map.find(i->getPredicate()) != map.end());
 	auto fptype = t->isVectorTy() ? t->getVectorElementType() : t;
-	fpcmp_op operation(map[i->getPredicate()], convert_fpsize(fptype));
+	fpcmp_op operation(map.at(i->getPredicate()), convert_fpsize(fptype));
 
 	if (t->isVectorTy())
 		tacs.push_back(vectorbinary_op::create(operation, op1, op2, *type));
@@ -788,11 +800,11 @@ convert_binary_operator(llvm::Instruction * instruction, tacsvector_t & tacs, co
 	auto t = i->getType()->isVectorTy() ? i->getType()->getVectorElementType() : i->getType();
 	if (t->isIntegerTy()) {
 		JLM_ASSERT(bitmap.find(i->getOpcode()) != bitmap.end());
-		operation = bitmap[i->getOpcode()](t->getIntegerBitWidth());
+		operation = bitmap.at(i->getOpcode())(t->getIntegerBitWidth());
 	} else if (t->isFloatingPointTy()) {
 		JLM_ASSERT(fpmap.find(i->getOpcode()) != fpmap.end());
 		JLM_ASSERT(fpsizemap.find(t->getTypeID()) != fpsizemap.end());
-		operation = std::make_unique<fpbin_op>(fpmap[i->getOpcode()], fpsizemap[t->getTypeID()]);
+		operation = std::make_unique<fpbin_op>(fpmap.at(i->getOpcode()), fpsizemap.at(t->getTypeID()));
 	} else
 		JLM_ASSERT(0);
 
@@ -946,7 +958,7 @@ convert_cast_instruction(llvm::Instruction * i, tacsvector_t & tacs, context & c
 	auto dsttype = convert_type(dt->isVectorTy() ? dt->getVectorElementType() : dt, ctx);
 
 	JLM_ASSERT(map.find(i->getOpcode()) != map.end());
-	auto unop = map[i->getOpcode()](std::move(srctype), std::move(dsttype));
+	auto unop = map.at(i->getOpcode())(std::move(srctype), std::move(dsttype));
 	JLM_ASSERT(is<jive::unary_op>(*unop));
 
 	if (dt->isVectorTy())
@@ -1010,7 +1022,7 @@ convert_instruction(
 	});
 
 	JLM_ASSERT(map.find(i->getOpcode()) != map.end());
-	return map[i->getOpcode()](i, tacs, ctx);
+	return map.at(i->getOpcode())(i, tacs, ctx);
 }
 
 }
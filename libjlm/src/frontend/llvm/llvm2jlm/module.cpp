@@ -16,6 +16,7 @@
 #include <jlm/frontend/llvm/llvm2jlm/instruction.hpp>
 #include <jlm/frontend/llvm/llvm2jlm/module.hpp>
 #include <jlm/frontend/llvm/llvm2jlm/type.hpp>
+#include <jlm/util/parallel.hpp>
 
 #include <jive/arch/addresstype.hpp>
 #include <jive/rvsdg/type.hpp>
@@ -26,6 +27,7 @@
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/Error.h>
 
 namespace jlm
 {
@@ -155,7 +157,7 @@ convert_attribute_kind(const llvm::Attribute::AttrKind & kind)
 	});
 
 	JLM_ASSERT(map.find(kind) != map.end());
-	return map[kind];
+	return map.at(kind);
 }
 
 static std::unique_ptr<jlm::attribute>
@@ -309,8 +311,7 @@ create_cfg(llvm::Function & f, context & ctx)
 		bb->add_outedge(cfg->exit());
 	}
 
-	straighten(*cfg);
-	prune(*cfg);
+	simplify(*cfg, false);
 	return cfg;
 }
 
@@ -322,9 +323,8 @@ convert_function(llvm::Function & function, context & ctx)
 
 	auto fv = static_cast<const fctvariable*>(ctx.lookup_value(&function));
 
-	ctx.set_node(fv->function());
-	fv->function()->add_cfg(create_cfg(function, ctx));
-	ctx.set_node(nullptr);
+	context fctx(ctx, fv->function());
+	fv->function()->add_cfg(create_cfg(function, fctx));
 }
 
 static const jlm::linkage &
@@ -345,7 +345,7 @@ convert_linkage(const llvm::GlobalValue::LinkageTypes & linkage)
 	});
 
 	JIVE_DEBUG_ASSERT(map.find(linkage) != map.end());
-	return map[linkage];
+	return map.at(linkage);
 }
 
 static void
@@ -413,8 +413,17 @@ convert_globals(llvm::Module & lm, context & ctx)
 	for (auto & gv : lm.getGlobalList())
 		convert_global_value(gv, ctx);
 
-	for (auto & f : lm.getFunctionList())
-		convert_function(f, ctx);
+	/*
+		The function bodies are converted in parallel. Every body is converted with its own context
+		that is layered over ctx, which only contains the global values at this point.
+	*/
+	std::vector<llvm::Function*> functions;
+	for (auto & f : lm.getFunctionList()) {
+		if (!f.isDeclaration())
+			functions.push_back(&f);
+	}
+
+	parallel_for(functions.size(), [&](size_t n){ convert_function(*functions[n], ctx); });
 }
 
 std::unique_ptr<ipgraph_module>
@@ -430,4 +439,133 @@ convert_module(llvm::Module & m)
 	return im;
 }
 
+/* lazy module converter */
+
+/*
+	Maps the global values of \p scan to the corresponding global values of \p module. Both
+	modules are loaded from the same input, such that their global values appear in the same
+	order.
+*/
+static std::unordered_map<const llvm::GlobalValue*, llvm::GlobalValue*>
+map_globals(llvm::Module & scan, llvm::Module & module)
+{
+	std::unordered_map<const llvm::GlobalValue*, llvm::GlobalValue*> map;
+	auto zip = [&](auto & list1, auto & list2)
+	{
+		if (list1.size() != list2.size())
+			throw jlm::error("The scan module does not match the converted module.");
+
+		for (auto it1 = list1.begin(), it2 = list2.begin(); it1 != list1.end(); it1++, it2++)
+			map[&*it1] = &*it2;
+	};
+
+	zip(scan.getFunctionList(), module.getFunctionList());
+	zip(scan.getGlobalList(), module.getGlobalList());
+	zip(scan.getAliasList(), module.getAliasList());
+	zip(scan.getIFuncList(), module.getIFuncList());
+
+	return map;
+}
+
+/*
+	Records the functions and global variables that are referenced by the body of \p function as
+	dependencies of its function node. The body belongs to the scan module, and its global values
+	are translated to the converted module with \p globals. The dependencies are recorded with the
+	same helper that convert_value() uses during the conversion of the body.
+*/
+static void
+collect_dependencies(
+	llvm::Function & function,
+	const std::unordered_map<const llvm::GlobalValue*, llvm::GlobalValue*> & globals,
+	context & ctx)
+{
+	auto fv = static_cast<const fctvariable*>(ctx.lookup_value(globals.at(&function)));
+	auto node = fv->function();
+
+	std::vector<const llvm::Value*> stack;
+	std::unordered_set<const llvm::Value*> visited;
+	for (auto & bb : function) {
+		for (auto & instruction : bb) {
+			for (auto & operand : instruction.operands())
+				stack.push_back(operand.get());
+		}
+	}
+
+	while (!stack.empty()) {
+		auto value = stack.back();
+		stack.pop_back();
+		if (!visited.insert(value).second)
+			continue;
+
+		if (auto gv = llvm::dyn_cast<llvm::GlobalValue>(value)) {
+			auto it = globals.find(gv);
+			if (it != globals.end())
+				add_dependency(*node, it->second, ctx);
+			continue;
+		}
+
+		if (auto constant = llvm::dyn_cast<llvm::Constant>(value)) {
+			for (auto & operand : constant->operands())
+				stack.push_back(operand.get());
+		}
+	}
+}
+
+lazy_module_converter::~lazy_module_converter()
+{}
+
+lazy_module_converter::lazy_module_converter(llvm::Module & module, llvm::Module & scan)
+{
+	filepath fp(module.getSourceFileName());
+	im_ = ipgraph_module::create(fp, module.getTargetTriple(), module.getDataLayoutStr());
+	ctx_ = std::make_unique<context>(*im_);
+
+	declare_globals(module, *ctx_);
+	for (auto & gv : module.getGlobalList())
+		convert_global_value(gv, *ctx_);
+
+	/*
+		The bodies of the scan module are materialized one at a time, and deleted as soon as their
+		dependencies are collected. The bodies of the converted module stay unmaterialized.
+	*/
+	auto globals = map_globals(scan, module);
+	for (auto & f : scan.getFunctionList()) {
+		if (auto error = f.materialize())
+			throw jlm::error(llvm::toString(std::move(error)));
+
+		if (f.isDeclaration())
+			continue;
+
+		collect_dependencies(f, globals, *ctx_);
+		f.deleteBody();
+
+		auto function = llvm::cast<llvm::Function>(globals.at(&f));
+		auto fv = static_cast<const fctvariable*>(ctx_->lookup_value(function));
+		functions_[fv->function()] = function;
+	}
+}
+
+void
+lazy_module_converter::materialize(const function_node & node)
+{
+	auto it = functions_.find(&node);
+	if (it == functions_.end())
+		return;
+
+	auto & function = *it->second;
+	functions_.erase(it);
+
+	if (auto error = function.materialize())
+		throw jlm::error(llvm::toString(std::move(error)));
+
+	convert_function(function, *ctx_);
+	function.deleteBody();
+}
+
+void
+lazy_module_converter::release(function_node & node)
+{
+	node.remove_cfg();
+}
+
 }
@@ -33,7 +33,7 @@ convert_fpsize(const llvm::Type * type)
 	});
 
 	JLM_ASSERT(map.find(type->getTypeID()) != map.end());
-	return map[type->getTypeID()];
+	return map.at(type->getTypeID());
 }
 
 static std::unique_ptr<jive::valuetype>
@@ -92,7 +92,7 @@ convert_fp_type(const llvm::Type * t, context & ctx)
 	});
 
 	JLM_ASSERT(map.find(t->getTypeID()) != map.end());
-	return std::unique_ptr<jive::valuetype>(new jlm::fptype(map[t->getTypeID()]));
+	return std::unique_ptr<jive::valuetype>(new jlm::fptype(map.at(t->getTypeID())));
 }
 
 static inline std::unique_ptr<jive::valuetype>
@@ -145,7 +145,7 @@ convert_type(const llvm::Type * t, context & ctx)
 	});
 
 	JLM_ASSERT(map.find(t->getTypeID()) != map.end());
-	return map[t->getTypeID()](t, ctx);
+	return map.at(t->getTypeID())(t, ctx);
 }
 
 }
@@ -18,40 +18,79 @@ namespace jlm {
 /* aggnode class */
 
 aggnode::~aggnode()
-{}
+{
+	/*
+		Destroy the subtree iteratively such that the destruction of deeply nested trees does not
+		recurse through the destructors of all its nodes.
+	*/
+	std::vector<std::unique_ptr<aggnode>> nodes(std::move(children_));
+	while (!nodes.empty()) {
+		auto node = std::move(nodes.back());
+		nodes.pop_back();
+		if (!node)
+			continue;
 
-void
-aggnode::normalize(aggnode & node)
+		for (auto & child : node->children_)
+			nodes.push_back(std::move(child));
+	}
+}
+
+size_t
+aggnode::nnodes() const noexcept
 {
-	std::function<std::vector<std::unique_ptr<aggnode>>(aggnode&)> reduce = [&](aggnode & node)
-	{
-		JLM_ASSERT(is<linearaggnode>(&node));
+	size_t n = 0;
+	std::vector<const aggnode*> stack({this});
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+
+		n++;
+		for (auto & child : node->children_)
+			stack.push_back(child.get());
+	}
 
-		std::vector<std::unique_ptr<aggnode>> children;
-		for (size_t n = 0; n < node.children_.size(); n++) {
-			auto & child = node.children_[n];
+	return n;
+}
+
+void
+aggnode::normalize(aggnode & root)
+{
+	std::vector<aggnode*> stack({&root});
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+
+		if (is<linearaggnode>(node)) {
+			/*
+				Splice the children of nested linear nodes into this node. The work list holds the
+				children in reverse order such that their original order is retained.
+			*/
+			std::vector<std::unique_ptr<aggnode>> worklist;
+			for (auto it = node->children_.rbegin(); it != node->children_.rend(); it++)
+				worklist.push_back(std::move(*it));
+
+			std::vector<std::unique_ptr<aggnode>> children;
+			while (!worklist.empty()) {
+				auto child = std::move(worklist.back());
+				worklist.pop_back();
+
+				if (is<linearaggnode>(child.get())) {
+					for (auto it = child->children_.rbegin(); it != child->children_.rend(); it++)
+						worklist.push_back(std::move(*it));
+					continue;
+				}
 
-			if (is<linearaggnode>(child.get())) {
-				auto tmp = reduce(*child);
-				std::move(tmp.begin(), tmp.end(), std::back_inserter(children));
-			} else {
 				children.push_back(std::move(child));
 			}
-		}
-
-		return children;
-	};
 
-	if (is<linearaggnode>(&node)) {
-		auto children = reduce(node);
+			node->remove_children();
+			for (auto & child : children)
+				node->add_child(std::move(child));
+		}
 
-		node.remove_children();
-		for (auto & child : children)
-			node.add_child(std::move(child));
+		for (auto & child : *node)
+			stack.push_back(&child);
 	}
-
-	for (auto & child : node)
-		normalize(child);
 }
 
 /* entryaggnode class */
@@ -134,34 +173,47 @@ loopaggnode::debug_string() const
 
 /** Aggregation map
 *
-* It associates CFG nodes with aggregation subtrees.
+* It associates CFG nodes with aggregation subtrees. The subtrees are stored in a flat array that
+* is indexed by dense node indices. The indices are handed out in the order in which the CFG nodes
+* are inserted. Every reduction replaces at least two CFG nodes with a single new node, such that
+* the array holds at most twice as many subtrees as the CFG has nodes.
 */
 class aggregation_map final {
 public:
 	bool
-	contains(jlm::cfg_node * node) const
+	contains(const jlm::cfg_node * node) const
 	{
-		return map_.find(node) != map_.end();
+		auto it = indices_.find(node);
+		return it != indices_.end() && subtrees_[it->second] != nullptr;
 	}
 
 	std::unique_ptr<aggnode>&
-	lookup(cfg_node * node)
+	lookup(const cfg_node * node)
 	{
 		JLM_ASSERT(contains(node));
 
-		return map_.at(node);
+		return subtrees_[indices_.at(node)];
 	}
 
 	void
-	insert(cfg_node * node, std::unique_ptr<aggnode> anode)
+	insert(const cfg_node * node, std::unique_ptr<aggnode> anode)
 	{
-		map_[node] = std::move(anode);
+		auto it = indices_.find(node);
+		if (it != indices_.end()) {
+			subtrees_[it->second] = std::move(anode);
+			return;
+		}
+
+		indices_[node] = subtrees_.size();
+		subtrees_.push_back(std::move(anode));
 	}
 
 	void
-	remove(cfg_node * node)
+	remove(const cfg_node * node)
 	{
-		map_.erase(node);
+		auto it = indices_.find(node);
+		if (it != indices_.end())
+			subtrees_[it->second].reset();
 	}
 
 	static std::unique_ptr<aggregation_map>
@@ -170,19 +222,22 @@ public:
 		auto exit = cfg.exit();
 		auto entry = cfg.entry();
 		auto map = std::make_unique<aggregation_map>();
+		map->indices_.reserve(2*(cfg.nnodes()+2));
+		map->subtrees_.reserve(2*(cfg.nnodes()+2));
 
-		map->map_[entry] = entryaggnode::create(entry->arguments());
-		map->map_[exit] = exitaggnode::create(exit->results());
+		map->insert(entry, entryaggnode::create(entry->arguments()));
+		map->insert(exit, exitaggnode::create(exit->results()));
 		for (auto & node : cfg) {
 			auto bb = static_cast<basic_block*>(&node);
-			map->map_[&node] = blockaggnode::create(std::move(bb->tacs()));
+			map->insert(&node, blockaggnode::create(std::move(bb->tacs())));
 		}
 
 		return map;
 	}
 
 private:
-	std::unordered_map<cfg_node*, std::unique_ptr<aggnode>> map_;
+	std::vector<std::unique_ptr<aggnode>> subtrees_;
+	std::unordered_map<const cfg_node*, size_t> indices_;
 };
 
 static bool
@@ -239,29 +294,46 @@ is_linear(const cfg_node * node) noexcept
 	return true;
 }
 
-static cfg_node *
-aggregate(cfg_node*, cfg_node*, aggregation_map&);
-
 /**
-* Reduces a tail-controlled loop subgraph to a single node and creates an aggregation subtree for
-* the subgraph.
+* Find all tail-controlled loops in an SESE subgraph and remove their repetition edges. The
+* returned entry and exit nodes delimit the SESE subgraph of each loop body, which needs to be
+* aggregated before the loop itself can be reduced with \ref reduce_loop().
 */
-static void
-reduce_loop(
-	const sccstructure & sccstruct,
-	aggregation_map & map)
+static std::vector<std::pair<cfg_node*, cfg_node*>>
+extract_loops(cfg_node * entry, cfg_node * exit)
 {
-	JLM_ASSERT(sccstruct.is_tcloop());
+	std::vector<std::pair<cfg_node*, cfg_node*>> loops;
+
+	auto sccs = find_sccs(entry, exit);
+	for (auto scc : sccs) {
+		auto sccstruct = sccstructure::create(scc);
+
+		if (sccstruct->is_tcloop()) {
+			auto lexit = (*sccstruct->xedges().begin())->source();
+			auto lentry = *sccstruct->enodes().begin();
+
+			auto redge = *sccstruct->redges().begin();
+			redge->source()->remove_outedge(redge->index());
+
+			loops.push_back({lentry, lexit});
+			continue;
+		}
 
-	auto exit = (*sccstruct.xedges().begin())->source();
-	auto entry = *sccstruct.enodes().begin();
+		JLM_UNREACHABLE("We should have never reached this point!");
+	}
 
-	auto redge = *sccstruct.redges().begin();
-	redge->source()->remove_outedge(redge->index());
+	return loops;
+}
 
-	auto sese = aggregate(entry, exit, map);
-	auto loop = loopaggnode::create(std::move(map.lookup(sese)));
-	map.insert(sese, std::move(loop));
+/**
+* Reduces the SESE subgraph of a tail-controlled loop, which was already aggregated to the single
+* node \p body, to a loop aggregation subtree.
+*/
+static void
+reduce_loop(cfg_node * body, aggregation_map & map)
+{
+	auto loop = loopaggnode::create(std::move(map.lookup(body)));
+	map.insert(body, std::move(loop));
 }
 
 /**
@@ -385,95 +457,100 @@ reduce_linear(
 	return sese;
 }
 
-/**
-* Find all tail-controlled loops in an SESE subgraph and reduce each loop to a single node.
-*/
-static void
-aggregate_loops(
-	cfg_node * entry,
-	cfg_node * exit,
-	aggregation_map & map)
-{
-	auto sccs = find_sccs(entry, exit);
-	for (auto scc : sccs) {
-		auto sccstruct = sccstructure::create(scc);
-
-		if (sccstruct->is_tcloop()) {
-			reduce_loop(*sccstruct, map);
-			continue;
-		}
-
-		JLM_UNREACHABLE("We should have never reached this point!");
-	}
-}
-
 static void
 aggregate_acyclic_sese(
-	cfg_node * node,
+	cfg_node * start,
 	cfg_node ** entry,
 	cfg_node ** exit,
 	aggregation_map & map)
 {
 	/*
-		We reduced the entire subgraph to a single node. We are done here.
+		The subgraph is traversed with an explicit stack instead of recursion. A frame records a node
+		and, for branch splits, the number of branches that were already visited.
 	*/
-	if (*entry == *exit) {
-		JLM_ASSERT(node == *entry);
-		return;
-	}
+	struct frame {
+		cfg_node * node;
+		size_t nbranches;
+	};
 
-	/*
-		We traversed the entire subgraph until the end. Turn around.
-	*/
-	if (node == *exit)
-		return;
+	std::vector<frame> stack({{start, 0}});
+	while (!stack.empty()) {
+		auto node = stack.back().node;
 
-	/*
-		Reduce linear subgraph
-	*/
-	if (is_linear(node)) {
-		auto sese = reduce_linear(node, entry, exit, map);
-		aggregate_acyclic_sese(sese, entry, exit, map);
-		return;
-	}
+		/*
+			We are returning to a branch split, whose branches we have not all reduced yet.
+		*/
+		if (stack.back().nbranches != 0) {
+			auto & nbranches = stack.back().nbranches;
+			if (nbranches <= node->noutedges()) {
+				auto sink = node->outedge(nbranches-1)->sink();
+				nbranches++;
+				stack.push_back({sink, 0});
+				continue;
+			}
+
+			/*
+				..., then try to reduce the branch subgraph itself.
+			*/
+			if (is_branch(node)) {
+				stack.back() = {reduce_branch(node, entry, exit, map), 0};
+				continue;
+			}
+
+			JLM_UNREACHABLE("We should have never reached this point!");
+		}
 
-	/*
-		Reduce branch subgraph
-	*/
-	if (is_branch_split(node)) {
 		/*
-			First, greedily reduce all branches of the branch subgraph...
+			We reduced the entire subgraph to a single node. We are done here.
 		*/
-		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++)
-			aggregate_acyclic_sese(it->sink(), entry, exit, map);
+		if (*entry == *exit) {
+			JLM_ASSERT(node == *entry);
+			stack.pop_back();
+			continue;
+		}
 
 		/*
-			..., then try to reduce the branch subgraph itself.
+			We traversed the entire subgraph until the end. Turn around.
 		*/
-		if (is_branch(node)) {
-			auto sese = reduce_branch(node, entry, exit, map);
-			aggregate_acyclic_sese(sese, entry, exit, map);
-			return;
+		if (node == *exit) {
+			stack.pop_back();
+			continue;
 		}
 
-		JLM_UNREACHABLE("We should have never reached this point!");
-	}
+		/*
+			Reduce linear subgraph
+		*/
+		if (is_linear(node)) {
+			stack.back().node = reduce_linear(node, entry, exit, map);
+			continue;
+		}
 
-	/*
-		It is only a single basic block with one incoming and outgoing edge, simply step over it.
-	*/
-	if (is_sese_basic_block(node)) {
-		aggregate_acyclic_sese(node->outedge(0)->sink(), entry, exit, map);
-		return;
-	}
+		/*
+			Reduce branch subgraph. First, greedily reduce all branches of the branch subgraph...
+		*/
+		if (is_branch_split(node)) {
+			stack.back().nbranches = 1;
+			continue;
+		}
 
-	/*
-		It is a branch join, turn around to the branch split such that we can reduce it.
-	*/
-	if (is_branch_join(node))
-		return;
+		/*
+			It is only a single basic block with one incoming and outgoing edge, simply step over it.
+		*/
+		if (is_sese_basic_block(node)) {
+			stack.back().node = node->outedge(0)->sink();
+			continue;
+		}
+
+		/*
+			It is a branch join, turn around to the branch split such that we can reduce it.
+		*/
+		if (is_branch_join(node)) {
+			stack.pop_back();
+			continue;
+		}
 
-	JLM_UNREACHABLE("We should have never reached this point!");
+		JLM_UNREACHABLE("We should have never reached this point!");
+	}
 }
 
 /**
@@ -482,13 +559,14 @@ aggregate_acyclic_sese(
 * The subgraph is then replaced by a single basic block in the CFG and this CFG is associated with
 * the aggregation subtree in the aggregation map.
 *
-* The function consists of two recursively nested phases:
+* The function consists of two nested phases:
 * 1. Loop aggregation
 * 2. Acyclic SESE aggregation.
 *
-* The first phase finds all tail-controlled loops and recursively invokes the aggregation procedure
-* on a loops' body to reduce it to a single node. Once all loops in the subgraph have been
-* reduced, the Acyclic SESE aggregation reduces the rest of the acyclic graph into a tree.
+* The first phase finds all tail-controlled loops and aggregates a loops' body to a single node.
+* Once all loops in the subgraph have been reduced, the Acyclic SESE aggregation reduces the rest
+* of the acyclic graph into a tree. Nested loop bodies are processed with an explicit stack of
+* SESE subgraphs instead of recursion.
 */
 static cfg_node *
 aggregate(
@@ -496,11 +574,37 @@ aggregate(
 	cfg_node * exit,
 	aggregation_map & map)
 {
-	aggregate_loops(entry, exit, map);
-	aggregate_acyclic_sese(entry, &entry, &exit, map);
-	JLM_ASSERT(entry == exit);
+	struct sese {
+		cfg_node * entry;
+		cfg_node * exit;
+		bool isloop;
+		bool expanded;
+	};
+
+	cfg_node * root = nullptr;
+	std::vector<sese> stack({{entry, exit, false, false}});
+	while (!stack.empty()) {
+		if (!stack.back().expanded) {
+			stack.back().expanded = true;
+			auto loops = extract_loops(stack.back().entry, stack.back().exit);
+			for (const auto & loop : loops)
+				stack.push_back({loop.first, loop.second, true, false});
+			continue;
+		}
 
-	return entry;
+		auto s = stack.back();
+		stack.pop_back();
+
+		aggregate_acyclic_sese(s.entry, &s.entry, &s.exit, map);
+		JLM_ASSERT(s.entry == s.exit);
+
+		if (s.isloop)
+			reduce_loop(s.entry, map);
+
+		root = s.entry;
+	}
+
+	return root;
 }
 
 std::unique_ptr<aggnode>
@@ -518,11 +622,17 @@ size_t
 ntacs(const jlm::aggnode & root)
 {
 	size_t n = 0;
-	for (auto & child : root)
-		n += ntacs(child);
+	std::vector<const aggnode*> stack({&root});
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+
+		if (auto bb = dynamic_cast<const blockaggnode*>(node))
+			n += bb->tacs().ntacs();
 
-	if (auto bb = dynamic_cast<const blockaggnode*>(&root))
-		n += bb->tacs().ntacs();
+		for (auto & child : *node)
+			stack.push_back(&child);
+	}
 
 	return n;
 }
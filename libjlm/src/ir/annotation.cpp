@@ -9,6 +9,7 @@
 #include <jlm/ir/operators/operators.hpp>
 
 #include <algorithm>
+#include <deque>
 #include <functional>
 #include <typeindex>
 
@@ -19,9 +20,6 @@ demandset::~demandset()
 
 /* read-write annotation */
 
-static void
-annotaterw(const aggnode * node, demandmap & dm);
-
 static void
 annotaterw(const entryaggnode * node, demandmap & dm)
 {
@@ -141,17 +139,34 @@ annotaterw(const aggnode * node, demandmap & dm)
 	, {typeid(loopaggnode), annotaterw<loopaggnode>}
 	});
 
-	for (size_t n = 0; n < node->nchildren(); n++)
-		annotaterw(node->child(n), dm);
-
 	JLM_ASSERT(map.find(typeid(*node)) != map.end());
 	return map[typeid(*node)](node, dm);
 }
 
-/* demandset annotation */
-
+/*
+	Annotates the tree in post-order, i.e., children before their parents, with an explicit stack
+	instead of recursion.
+*/
 static void
-annotateds(const aggnode*, variableset&, demandmap&);
+annotaterw(const aggnode & root, demandmap & dm)
+{
+	std::vector<std::pair<const aggnode*, size_t>> stack({{&root, 0}});
+	while (!stack.empty()) {
+		auto node = stack.back().first;
+		auto & nvisited = stack.back().second;
+
+		if (nvisited < node->nchildren()) {
+			auto child = node->child(nvisited++);
+			stack.push_back({child, 0});
+			continue;
+		}
+
+		annotaterw(node, dm);
+		stack.pop_back();
+	}
+}
+
+/* demandset annotation */
 
 static void
 annotateds(
@@ -197,17 +212,39 @@ annotateds(
 	ds->top = pds;
 }
 
+/*
+	A frame of the demand set annotation. It records the demand set \p pds that is propagated
+	through the node and the number of children that were already annotated. Branch nodes
+	annotate each of their children with a fresh copy of their \p bottom demand set.
+*/
+struct dsframe {
+	inline
+	dsframe(const aggnode * n, variableset * p)
+	: node(n)
+	, pds(p)
+	, nvisited(0)
+	{}
+
+	const aggnode * node;
+	variableset * pds;
+	size_t nvisited;
+	variableset passby;
+	variableset bottom;
+	variableset tmp;
+};
+
 static void
-annotateds(
-	const linearaggnode * node,
-	variableset & pds,
-	demandmap & dm)
+enter_linear(dsframe & frame, demandmap & dm)
 {
-	auto & ds = dm[node];
-	ds->bottom = pds;
+	auto & ds = dm[frame.node];
+	ds->bottom = *frame.pds;
+}
 
-	for (ssize_t n = node->nchildren()-1; n >= 0; n--)
-		annotateds(node->child(n), pds, dm);
+static void
+leave_linear(dsframe & frame, demandmap & dm)
+{
+	auto & ds = dm[frame.node];
+	auto & pds = *frame.pds;
 
 	pds.remove(ds->fullwrites);
 	pds.insert(ds->reads);
@@ -216,44 +253,47 @@ annotateds(
 }
 
 static void
-annotateds(
-	const branchaggnode * node,
-	variableset & pds,
-	demandmap & dm)
+enter_branch(dsframe & frame, demandmap & dm)
 {
-	auto & ds = dm[node];
-
-	variableset passby = pds;
-	passby.subtract(ds->allwrites);
+	auto & ds = dm[frame.node];
+	auto & pds = *frame.pds;
 
-	variableset bottom = pds;
-	bottom.intersect(ds->allwrites);
-	ds->bottom = bottom;
+	frame.passby = pds;
+	frame.passby.subtract(ds->allwrites);
 
-	for (size_t n = 0; n < node->nchildren(); n++) {
-		auto tmp = bottom;
-		annotateds(node->child(n), tmp, dm);
-	}
+	frame.bottom = pds;
+	frame.bottom.intersect(ds->allwrites);
+	ds->bottom = frame.bottom;
+}
 
+static void
+leave_branch(dsframe & frame, demandmap & dm)
+{
+	auto & ds = dm[frame.node];
+	auto & pds = *frame.pds;
 
 	pds.remove(ds->fullwrites);
 	pds.insert(ds->reads);
 	ds->top = pds;
 
-	pds.insert(passby);
+	pds.insert(frame.passby);
 }
 
 static void
-annotateds(
-	const loopaggnode * node,
-	variableset & pds,
-	demandmap & dm)
+enter_loop(dsframe & frame, demandmap & dm)
 {
-	auto & ds = dm[node];
+	auto & ds = dm[frame.node];
+	auto & pds = *frame.pds;
 
 	pds.insert(ds->reads);
 	ds->bottom = ds->top = pds;
-	annotateds(node->child(0), pds, dm);
+}
+
+static void
+leave_loop(dsframe & frame, demandmap & dm)
+{
+	auto & ds = dm[frame.node];
+	auto & pds = *frame.pds;
 
 	for (const auto & v : ds->reads)
 		JLM_ASSERT(pds.contains(v));
@@ -263,36 +303,89 @@ annotateds(
 			JLM_ASSERT(!pds.contains(v));
 }
 
-template<class T> static void
-annotateds(
-	const aggnode * node,
-	variableset & pds,
-	demandmap & dm)
-{
-	JLM_ASSERT(is<T>(node));
-	annotateds(static_cast<const T*>(node), pds, dm);
-}
-
+/*
+	Annotates the tree with demand sets in a single top-down pass with an explicit stack of frames
+	instead of recursion. Linear nodes propagate the demand set through their children in reverse
+	order, branch nodes through each child separately, and loop nodes through their body.
+*/
 static void
 annotateds(
-	const aggnode * node,
+	const aggnode & root,
 	variableset & pds,
 	demandmap & dm)
 {
-	static std::unordered_map<
-		std::type_index,
-		void(*)(const aggnode*, variableset&, demandmap&)
-	> map({
-	  {typeid(entryaggnode), annotateds<entryaggnode>}
-	, {typeid(exitaggnode), annotateds<exitaggnode>}
-	, {typeid(blockaggnode), annotateds<blockaggnode>}
-	, {typeid(linearaggnode), annotateds<linearaggnode>}
-	, {typeid(branchaggnode), annotateds<branchaggnode>}
-	, {typeid(loopaggnode), annotateds<loopaggnode>}
-	});
+	/* frames must not move as children refer to the demand sets of their parents */
+	std::deque<dsframe> stack;
+	stack.emplace_back(&root, &pds);
+	while (!stack.empty()) {
+		auto & frame = stack.back();
+		auto node = frame.node;
+
+		if (auto en = dynamic_cast<const entryaggnode*>(node)) {
+			annotateds(en, *frame.pds, dm);
+			stack.pop_back();
+			continue;
+		}
 
-	JLM_ASSERT(map.find(typeid(*node)) != map.end());
-	return map[typeid(*node)](node, pds, dm);
+		if (auto xn = dynamic_cast<const exitaggnode*>(node)) {
+			annotateds(xn, *frame.pds, dm);
+			stack.pop_back();
+			continue;
+		}
+
+		if (auto bn = dynamic_cast<const blockaggnode*>(node)) {
+			annotateds(bn, *frame.pds, dm);
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<linearaggnode>(node)) {
+			if (frame.nvisited == 0)
+				enter_linear(frame, dm);
+
+			if (frame.nvisited < node->nchildren()) {
+				auto child = node->child(node->nchildren()-1-frame.nvisited++);
+				stack.emplace_back(child, frame.pds);
+				continue;
+			}
+
+			leave_linear(frame, dm);
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<branchaggnode>(node)) {
+			if (frame.nvisited == 0)
+				enter_branch(frame, dm);
+
+			if (frame.nvisited < node->nchildren()) {
+				auto child = node->child(frame.nvisited++);
+				frame.tmp = frame.bottom;
+				stack.emplace_back(child, &frame.tmp);
+				continue;
+			}
+
+			leave_branch(frame, dm);
+			stack.pop_back();
+			continue;
+		}
+
+		if (is<loopaggnode>(node)) {
+			JLM_ASSERT(node->nchildren() == 1);
+			if (frame.nvisited == 0) {
+				enter_loop(frame, dm);
+				frame.nvisited++;
+				stack.emplace_back(node->child(0), frame.pds);
+				continue;
+			}
+
+			leave_loop(frame, dm);
+			stack.pop_back();
+			continue;
+		}
+
+		JLM_UNREACHABLE("Unhandled aggregation node type.");
+	}
 }
 
 demandmap
@@ -300,8 +393,8 @@ annotate(const aggnode & root)
 {
 	demandmap dm;
 	variableset ds;
-	annotaterw(&root, dm);
-	annotateds(&root, ds, dm);
+	annotaterw(root, dm);
+	annotateds(root, ds, dm);
 	return dm;
 }
 
@@ -8,6 +8,8 @@
 #include <jlm/ir/cfg-structure.hpp>
 #include <jlm/ir/operators/operators.hpp>
 
+#include <jive/rvsdg/control.hpp>
+
 #include <algorithm>
 #include <unordered_map>
 
@@ -185,6 +187,18 @@ is_linear_reduction(const jlm::cfg_node * node) noexcept
 	return true;
 }
 
+/*
+	Checks whether \p node is a basic block that starts with a phi. Merging a block into it or
+	diverting the edges of an empty block to it would leave its phis behind other tacs or with
+	operands from removed blocks.
+*/
+static inline bool
+starts_with_phi(const jlm::cfg_node * node) noexcept
+{
+	auto bb = dynamic_cast<const jlm::basic_block*>(node);
+	return bb && bb->ntacs() != 0 && jlm::is<jlm::phi_op>(bb->first());
+}
+
 static inline jlm::cfg_node *
 find_join(const jlm::cfg_node * split) noexcept
 {
@@ -616,7 +630,8 @@ straighten(jlm::cfg & cfg)
 	while (it != cfg.end()) {
 		if (is_linear_reduction(it.node())
 		&& is<basic_block>(it.node())
-		&& is<basic_block>(it->outedge(0)->sink())) {
+		&& is<basic_block>(it->outedge(0)->sink())
+		&& !starts_with_phi(it->outedge(0)->sink())) {
 			static_cast<basic_block*>(it->outedge(0)->sink())->append_first(it.node()->tacs());
 			it->divert_inedges(it->outedge(0)->sink());
 			it = cfg.remove_node(it);
@@ -761,4 +776,414 @@ prune(jlm::cfg & cfg)
 	JLM_ASSERT(is_closed(cfg));
 }
 
+/* fused simplification */
+
+void
+simplify(jlm::cfg & cfg, bool purge)
+{
+	JLM_ASSERT(is_valid(cfg));
+
+	/*
+		Number all nodes reachable from the entry. The indices are used for the bookkeeping of the
+		worklist below, such that the iteration itself performs no hashing.
+	*/
+	std::vector<cfg_node*> nodes;
+	std::unordered_map<const cfg_node*, size_t> indices;
+	std::vector<cfg_node*> stack({cfg.entry()});
+	indices[cfg.entry()] = 0;
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+		nodes.push_back(node);
+
+		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+			if (indices.insert({it->sink(), indices.size()}).second)
+				stack.push_back(it->sink());
+		}
+	}
+
+	/* prune nodes that are not reachable from the entry */
+	if (indices.size() != cfg.nnodes() + 2) {
+		std::unordered_set<cfg_node*> deadnodes;
+		for (auto & node : cfg) {
+			if (indices.find(&node) == indices.end())
+				deadnodes.insert(&node);
+		}
+
+		auto sinks = compute_live_sinks(deadnodes);
+		update_phi_operands(sinks, deadnodes);
+		remove_deadnodes(deadnodes);
+	}
+
+	/*
+		Purge empty basic blocks and merge linear chains of basic blocks. Every removal can only
+		enable further removals at the predecessors and the successor of the removed block, which
+		are therefore put back on the worklist. Blocks that start with a phi are never the target
+		of a removal, since pruning can leave them with a single predecessor.
+	*/
+	std::vector<bool> removed(indices.size(), false);
+	std::vector<bool> queued(indices.size(), true);
+	std::vector<cfg_node*> worklist(nodes.rbegin(), nodes.rend());
+	auto enqueue = [&](cfg_node * node)
+	{
+		auto index = indices[node];
+		if (!removed[index] && !queued[index]) {
+			queued[index] = true;
+			worklist.push_back(node);
+		}
+	};
+
+	while (!worklist.empty()) {
+		auto node = worklist.back();
+		worklist.pop_back();
+
+		auto index = indices[node];
+		queued[index] = false;
+		if (removed[index] || !is<basic_block>(node))
+			continue;
+
+		auto bb = static_cast<basic_block*>(node);
+		JLM_ASSERT(bb->noutedges() != 0);
+		auto sink = bb->outedge(0)->sink();
+
+		bool purgeable = purge && bb->tacs().ntacs() == 0 && sink != bb && !starts_with_phi(sink);
+		JLM_ASSERT(!purgeable || bb->noutedges() == 1);
+		bool mergeable = is_linear_reduction(bb) && is<basic_block>(sink) && !starts_with_phi(sink);
+		if (!purgeable && !mergeable)
+			continue;
+
+		std::vector<cfg_node*> predecessors;
+		for (auto & inedge : bb->inedges())
+			predecessors.push_back(inedge->source());
+
+		if (mergeable)
+			static_cast<basic_block*>(sink)->append_first(bb->tacs());
+		bb->divert_inedges(sink);
+		cfg.remove_node(bb);
+		removed[index] = true;
+
+		enqueue(sink);
+		for (auto & predecessor : predecessors)
+			enqueue(predecessor);
+	}
+
+	JLM_ASSERT(is_closed(cfg));
+}
+
+/* branch threading */
+
+static const jive::ctlconstant_op *
+is_ctlconstant(const variable * v)
+{
+	auto tv = dynamic_cast<const tacvariable*>(v);
+	if (tv == nullptr || !is<jive::ctlconstant_op>(tv->tac()))
+		return nullptr;
+
+	return static_cast<const jive::ctlconstant_op*>(&tv->tac()->operation());
+}
+
+static const variable *
+phi_operand(const jlm::tac & phitac, const cfg_node * node)
+{
+	JLM_ASSERT(is<phi_op>(&phitac));
+	auto phi = static_cast<const phi_op*>(&phitac.operation());
+
+	for (size_t n = 0; n < phitac.noperands(); n++) {
+		if (phi->node(n) == node)
+			return phitac.operand(n);
+	}
+
+	JLM_UNREACHABLE("Node is not an incoming node of phi.");
+}
+
+static void
+append_phi_operand(jlm::tac & phitac, const variable * v, cfg_node * node)
+{
+	JLM_ASSERT(is<phi_op>(&phitac));
+	auto phi = static_cast<const phi_op*>(&phitac.operation());
+
+	std::vector<cfg_node*> nodes;
+	std::vector<const variable*> operands;
+	for (size_t n = 0; n < phitac.noperands(); n++) {
+		nodes.push_back(phi->node(n));
+		operands.push_back(phitac.operand(n));
+	}
+	nodes.push_back(node);
+	operands.push_back(v);
+
+	phitac.replace(phi_op(nodes, phi->type()), operands);
+}
+
+/*
+	Maps every variable to the tacs that use it and their basic blocks. Variables that are results
+	of the CFG are mapped to the exit node. The map also records the basic block of every tac, and
+	is updated incrementally while branches are threaded.
+*/
+class usermap final {
+public:
+	usermap(jlm::cfg & cfg)
+	{
+		for (auto & node : cfg) {
+			auto bb = static_cast<basic_block*>(&node);
+			for (const auto & tac : *bb) {
+				blocks_[tac] = bb;
+				insert(tac);
+			}
+		}
+
+		for (size_t n = 0; n < cfg.exit()->nresults(); n++)
+			users_[cfg.exit()->result(n)].push_back({nullptr, cfg.exit()});
+	}
+
+	const std::vector<std::pair<const tac*, cfg_node*>> *
+	users(const variable * v) const
+	{
+		auto it = users_.find(v);
+		return it != users_.end() ? &it->second : nullptr;
+	}
+
+	/*
+		Adds the uses of \p tac.
+	*/
+	void
+	insert(const tac * tac)
+	{
+		auto bb = blocks_[tac];
+		for (size_t n = 0; n < tac->noperands(); n++)
+			users_[tac->operand(n)].push_back({tac, bb});
+	}
+
+	/*
+		Removes the uses of \p tac. The blocks that define its operands are added to \p affected,
+		as removing a use can turn them into predicate blocks.
+	*/
+	void
+	erase(const tac * tac, std::vector<cfg_node*> & affected)
+	{
+		for (size_t n = 0; n < tac->noperands(); n++) {
+			auto & users = users_[tac->operand(n)];
+			users.erase(std::remove_if(users.begin(), users.end(),
+				[&](const std::pair<const jlm::tac*, cfg_node*> & user) { return user.first == tac; }),
+				users.end());
+
+			auto tv = dynamic_cast<const tacvariable*>(tac->operand(n));
+			auto it = tv ? blocks_.find(tv->tac()) : blocks_.end();
+			if (it != blocks_.end())
+				affected.push_back(it->second);
+		}
+	}
+
+private:
+	std::unordered_map<const tac*, basic_block*> blocks_;
+	std::unordered_map<const variable*, std::vector<std::pair<const tac*, cfg_node*>>> users_;
+};
+
+/*
+	Replaces a branch on a control constant with an unconditional edge.
+*/
+static bool
+fold_constant_branch(basic_block * bb, usermap & users, std::vector<cfg_node*> & affected)
+{
+	if (bb->noutedges() < 2 || !is<branch_op>(bb->last()))
+		return false;
+
+	auto cop = is_ctlconstant(bb->last()->operand(0));
+	if (cop == nullptr)
+		return false;
+
+	auto alternative = cop->value().alternative();
+	auto target = bb->outedge(alternative)->sink();
+
+	std::unordered_set<basic_block*> sinks;
+	for (size_t n = bb->noutedges(); n > 0; n--) {
+		if (n-1 == alternative)
+			continue;
+
+		if (auto sink = dynamic_cast<basic_block*>(bb->outedge(n-1)->sink()))
+			sinks.insert(sink);
+		bb->remove_outedge(n-1);
+	}
+	users.erase(bb->last(), affected);
+	bb->drop_last();
+
+	sinks.erase(static_cast<basic_block*>(target));
+	for (auto & sink : sinks) {
+		for (auto & tac : *sink) {
+			if (!is<phi_op>(tac))
+				break;
+
+			users.erase(tac, affected);
+			update_phi_operands(*tac, {bb});
+			users.insert(tac);
+		}
+		affected.push_back(sink);
+	}
+
+	return true;
+}
+
+/*
+	Checks whether \p bb only consists of phis and a branch on one of them. The phi results must
+	only be used by the branch or by phis of the block's successors for the edges from the block.
+	Returns the phi that computes the predicate.
+*/
+static const tac *
+is_predicate_block(const basic_block * bb, const usermap & users)
+{
+	if (bb->noutedges() < 2 || !is<branch_op>(bb->last()))
+		return nullptr;
+
+	auto predicate = dynamic_cast<const tacvariable*>(bb->last()->operand(0));
+	if (predicate == nullptr
+	|| !is<phi_op>(predicate->tac())
+	|| std::find(bb->begin(), bb->end(), predicate->tac()) == bb->end())
+		return nullptr;
+
+	std::unordered_set<const cfg_node*> successors;
+	for (auto it = bb->begin_outedges(); it != bb->end_outedges(); it++)
+		successors.insert(it->sink());
+
+	for (const auto & tac : *bb) {
+		if (tac == bb->last())
+			break;
+
+		if (!is<phi_op>(tac))
+			return nullptr;
+
+		auto tacusers = users.users(tac->result(0));
+		if (tacusers == nullptr)
+			continue;
+
+		for (const auto & user : *tacusers) {
+			if (user.first == bb->last())
+				continue;
+
+			if (user.first == nullptr
+			|| !is<phi_op>(user.first)
+			|| successors.find(user.second) == successors.end())
+				return nullptr;
+
+			auto phi = static_cast<const phi_op*>(&user.first->operation());
+			for (size_t n = 0; n < user.first->noperands(); n++) {
+				if (user.first->operand(n) == tac->result(0) && phi->node(n) != bb)
+					return nullptr;
+			}
+		}
+	}
+
+	return predicate->tac();
+}
+
+/*
+	Redirects a predecessor of the predicate block \p bb to the successor selected by the constant
+	it contributes to the predicate.
+*/
+static bool
+thread_predecessor(
+	basic_block * bb,
+	const tac * predicate,
+	usermap & users,
+	std::vector<cfg_node*> & affected)
+{
+	for (auto & inedge : bb->inedges()) {
+		auto source = inedge->source();
+		if (source == bb)
+			continue;
+
+		auto cop = is_ctlconstant(phi_operand(*predicate, source));
+		if (cop == nullptr)
+			continue;
+
+		auto target = bb->outedge(cop->value().alternative())->sink();
+		if (target == bb)
+			continue;
+
+		/*
+			The phis of the target would require two operands from the source.
+		*/
+		bool has_edge = false;
+		for (auto it = source->begin_outedges(); it != source->end_outedges(); it++)
+			has_edge = has_edge || it->sink() == target;
+		if (has_edge)
+			continue;
+
+		/*
+			Add the values the source contributes to the phis of the target. Values that are
+			computed by phis of the predicate block are resolved to their operand for the source.
+		*/
+		if (auto sink = dynamic_cast<basic_block*>(target)) {
+			for (auto & tac : *sink) {
+				if (!is<phi_op>(tac))
+					break;
+
+				auto v = phi_operand(*tac, bb);
+				auto tv = dynamic_cast<const tacvariable*>(v);
+				if (tv && is<phi_op>(tv->tac()) && std::find(bb->begin(), bb->end(), tv->tac()) != bb->end())
+					v = phi_operand(*tv->tac(), source);
+
+				users.erase(tac, affected);
+				append_phi_operand(*tac, v, source);
+				users.insert(tac);
+			}
+		}
+
+		for (auto & tac : *bb) {
+			if (!is<phi_op>(tac))
+				break;
+
+			users.erase(tac, affected);
+			update_phi_operands(*tac, {source});
+			users.insert(tac);
+		}
+
+		for (auto it = source->begin_outedges(); it != source->end_outedges(); it++) {
+			if (it->sink() == bb)
+				it->divert(target);
+		}
+
+		affected.insert(affected.end(), {bb, source, target});
+		return true;
+	}
+
+	return false;
+}
+
+void
+thread_branches(jlm::cfg & cfg)
+{
+	/*
+		A transformation can only enable further transformations at the blocks it changed and at
+		the blocks that define variables whose uses it removed. Only these blocks are revisited.
+	*/
+	usermap users(cfg);
+	std::vector<cfg_node*> worklist;
+	std::unordered_set<cfg_node*> queued;
+	for (auto & node : cfg) {
+		worklist.push_back(&node);
+		queued.insert(&node);
+	}
+	std::reverse(worklist.begin(), worklist.end());
+
+	std::vector<cfg_node*> affected;
+	while (!worklist.empty()) {
+		auto bb = static_cast<basic_block*>(worklist.back());
+		worklist.pop_back();
+		queued.erase(bb);
+
+		if (!fold_constant_branch(bb, users, affected)) {
+			auto predicate = is_predicate_block(bb, users);
+			if (predicate)
+				thread_predecessor(bb, predicate, users, affected);
+		}
+
+		for (auto & node : affected) {
+			if (is<basic_block>(node) && queued.insert(node).second)
+				worklist.push_back(node);
+		}
+		affected.clear();
+	}
+
+	simplify(cfg, false);
+}
+
 }
@@ -78,6 +78,20 @@ ipgraph::find_sccs() const
 	return sccs;
 }
 
+std::vector<std::unordered_set<ipgraph_node*>>
+ipgraph::find_sccs()
+{
+	/* the nodes are owned by this graph, such that it is safe to hand them out as non-const */
+	std::vector<std::unordered_set<ipgraph_node*>> sccs;
+	for (const auto & scc : static_cast<const ipgraph*>(this)->find_sccs()) {
+		sccs.push_back({});
+		for (const auto & node : scc)
+			sccs.back().insert(const_cast<ipgraph_node*>(node));
+	}
+
+	return sccs;
+}
+
 const ipgraph_node *
 ipgraph::find(const std::string & name) const noexcept
 {
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/operators/opcode.hpp>
+
+#include <jive/rvsdg/control.hpp>
+#include <jive/types/bitstring.hpp>
+
+#include <llvm/ADT/APFloat.h>
+
+#include <type_traits>
+#include <typeinfo>
+
+namespace jlm {
+
+#define JLM_OPCODE_CHECK(name, operation) \
+	static_assert(std::is_base_of<with_opcode<opcode::name>, operation>::value, \
+		"Opcode of " #operation " does not match.");
+JLM_IR_OPCODES(JLM_OPCODE_CHECK)
+#undef JLM_OPCODE_CHECK
+
+opcode
+get_opcode(const jive::operation & operation)
+{
+	if (auto op = dynamic_cast<const opcode_operation*>(&operation))
+		return op->code();
+
+	auto & type = typeid(operation);
+#define JLM_OPCODE_COMPARE(name, operation) \
+	if (type == typeid(operation)) \
+		return opcode::name;
+	JLM_JIVE_OPCODES(JLM_OPCODE_COMPARE)
+#undef JLM_OPCODE_COMPARE
+
+	return opcode::other;
+}
+
+static inline size_t
+combine(size_t h, size_t value)
+{
+	return h * 31 + value;
+}
+
+static size_t
+hash(const jive::type & type)
+{
+	auto h = typeid(type).hash_code();
+
+	if (auto bt = dynamic_cast<const jive::bittype*>(&type))
+		return combine(h, bt->nbits());
+
+	if (auto ct = dynamic_cast<const jive::ctltype*>(&type))
+		return combine(h, ct->nalternatives());
+
+	if (auto pt = dynamic_cast<const ptrtype*>(&type))
+		return combine(h, hash(pt->pointee_type()));
+
+	return h;
+}
+
+static size_t
+hash(const jive::bitvalue_repr & value)
+{
+	auto h = value.nbits();
+	if (value.is_known() && value.nbits() <= 64)
+		h = combine(h, value.to_uint());
+
+	return h;
+}
+
+size_t
+hash(const jive::operation & operation)
+{
+	auto code = get_opcode(operation);
+	size_t h = static_cast<size_t>(code);
+
+	switch (code) {
+		case opcode::gamma_op:
+			return combine(h, static_cast<const jive::gamma_op*>(&operation)->nalternatives());
+		case opcode::theta_op:
+		case opcode::phi:
+			return h;
+		case opcode::lambda: {
+			auto op = static_cast<const lambda::operation*>(&operation);
+			h = combine(h, std::hash<std::string>()(op->name()));
+			return combine(h, static_cast<size_t>(op->linkage()));
+		}
+		case opcode::delta: {
+			auto op = static_cast<const delta::operation*>(&operation);
+			h = combine(h, std::hash<std::string>()(op->name()));
+			return combine(h, hash(op->type()));
+		}
+		case opcode::bitconstant_op:
+			h = combine(h, hash(static_cast<const jive::bitconstant_op*>(&operation)->value()));
+			break;
+		case opcode::ctlconstant_op: {
+			auto & value = static_cast<const jive::ctlconstant_op*>(&operation)->value();
+			h = combine(h, value.alternative());
+			h = combine(h, value.nalternatives());
+			break;
+		}
+		case opcode::match_op: {
+			auto op = static_cast<const jive::match_op*>(&operation);
+			h = combine(h, op->default_alternative());
+			/* the mapping is unordered, such that its pairs are combined commutatively */
+			size_t mapping = 0;
+			for (const auto & pair : *op)
+				mapping += combine(pair.first, pair.second);
+			h = combine(h, mapping);
+			break;
+		}
+		case opcode::alloca_op:
+			h = combine(h, static_cast<const alloca_op*>(&operation)->alignment());
+			break;
+		case opcode::load_op:
+			h = combine(h, static_cast<const load_op*>(&operation)->alignment());
+			break;
+		case opcode::store_op:
+			h = combine(h, static_cast<const store_op*>(&operation)->alignment());
+			break;
+		case opcode::fpbin_op:
+			h = combine(h, static_cast<size_t>(static_cast<const fpbin_op*>(&operation)->fpop()));
+			break;
+		case opcode::fpcmp_op:
+			h = combine(h, static_cast<size_t>(static_cast<const fpcmp_op*>(&operation)->cmp()));
+			break;
+		case opcode::ptrcmp_op:
+			h = combine(h, static_cast<size_t>(static_cast<const ptrcmp_op*>(&operation)->cmp()));
+			break;
+		case opcode::fpconstant_op:
+			h = combine(h, llvm::hash_value(static_cast<const fpconstant_op*>(&operation)->constant()));
+			break;
+		case opcode::vectorunary_op:
+			h = combine(h, hash(static_cast<const vectorunary_op*>(&operation)->operation()));
+			break;
+		case opcode::vectorbinary_op:
+			h = combine(h, hash(static_cast<const vectorbinary_op*>(&operation)->operation()));
+			break;
+		case opcode::other:
+			h = combine(h, typeid(operation).hash_code());
+			if (!dynamic_cast<const jive::simple_op*>(&operation))
+				return h;
+			break;
+		default:
+			break;
+	}
+
+	/* all remaining parameters are determined by the operand and result types */
+	auto op = static_cast<const jive::simple_op*>(&operation);
+	for (size_t n = 0; n < op->narguments(); n++)
+		h = combine(h, hash(op->argument(n).type()));
+	for (size_t n = 0; n < op->nresults(); n++)
+		h = combine(h, hash(op->result(n).type()));
+
+	return h;
+}
+
+}
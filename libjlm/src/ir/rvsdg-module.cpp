@@ -3,8 +3,15 @@
  * See COPYING for terms of redistribution.
  */
 
+#include <jlm/common.hpp>
+#include <jlm/ir/operators/operators.hpp>
 #include <jlm/ir/rvsdg-module.hpp>
 
+#include <jive/rvsdg/notifiers.hpp>
+
+#include <functional>
+#include <unordered_map>
+
 namespace jlm {
 
 /* impport class */
@@ -28,4 +35,156 @@ impport::copy() const
 	return std::unique_ptr<port>(new impport(*this));
 }
 
+/* graph observer */
+
+/*
+	Forwards the jive node and input notifiers to the RVSDG module that owns the graph. Nodes of
+	graphs that do not belong to a module are ignored. All modules share a single observer, such
+	that every notification is only looked up once.
+*/
+class graph_observer final {
+public:
+	static graph_observer &
+	instance()
+	{
+		static graph_observer observer;
+		return observer;
+	}
+
+	void
+	insert(rvsdg_module & module)
+	{
+		modules_[module.graph()] = &module;
+	}
+
+	void
+	erase(const rvsdg_module & module)
+	{
+		modules_.erase(module.graph());
+	}
+
+	const rvsdg_module *
+	module(const jive::graph & graph) const
+	{
+		auto it = modules_.find(&graph);
+		return it != modules_.end() ? it->second : nullptr;
+	}
+
+private:
+	graph_observer()
+	{
+		using namespace std::placeholders;
+
+		callbacks_.push_back(jive::on_node_create.connect(
+			std::bind(&graph_observer::node_create, this, _1)));
+		callbacks_.push_back(jive::on_node_destroy.connect(
+			std::bind(&graph_observer::node_destroy, this, _1)));
+		callbacks_.push_back(jive::on_input_change.connect(
+			std::bind(&graph_observer::input_change, this, _1, _2, _3)));
+	}
+
+	rvsdg_module *
+	module(const jive::region * region) const
+	{
+		auto it = modules_.find(region->graph());
+		return it != modules_.end() ? it->second : nullptr;
+	}
+
+	void
+	node_create(jive::node * node)
+	{
+		auto module = this->module(node->region());
+		if (!module)
+			return;
+
+		module->nnodes_++;
+		if (module->records_touched_nodes())
+			module->touch(node);
+	}
+
+	void
+	node_destroy(jive::node * node)
+	{
+		auto module = this->module(node->region());
+		if (!module)
+			return;
+
+		JLM_ASSERT(module->nnodes_ != 0);
+		module->nnodes_--;
+		module->touched_set_.erase(node);
+	}
+
+	void
+	input_change(jive::input * input, jive::output*, jive::output*)
+	{
+		auto module = this->module(input->region());
+		if (!module || !module->records_touched_nodes())
+			return;
+
+		if (auto node = input_node(input)) {
+			module->touch(node);
+			return;
+		}
+
+		/* changed region results can render the structural node reducible, e.g. gammas */
+		if (auto node = input->region()->node())
+			module->touch(node);
+	}
+
+	std::vector<jive::callback> callbacks_;
+	std::unordered_map<const jive::graph*, rvsdg_module*> modules_;
+};
+
+size_t
+nnodes(const jive::graph & graph)
+{
+	if (auto module = graph_observer::instance().module(graph))
+		return module->nnodes();
+
+	return jive::nnodes(graph.root());
+}
+
+/* rvsdg module class */
+
+rvsdg_module::~rvsdg_module()
+{
+	graph_observer::instance().erase(*this);
+}
+
+rvsdg_module::rvsdg_module(
+	const jlm::filepath & source_filename,
+	const std::string & target_triple,
+	const std::string & data_layout)
+: nnodes_(jive::nnodes(graph_.root()))
+, record_touched_(false)
+, data_layout_(data_layout)
+, target_triple_(target_triple)
+, source_filename_(source_filename)
+{
+	graph_observer::instance().insert(*this);
+}
+
+void
+rvsdg_module::touch(jive::node * node)
+{
+	if (touched_set_.insert(node).second)
+		touched_.push_back(node);
+}
+
+jive::node *
+rvsdg_module::pop_touched_node()
+{
+	/*
+		Destroyed nodes are only removed from the set. Their queue entries are skipped here.
+	*/
+	while (!touched_.empty()) {
+		auto node = touched_.front();
+		touched_.pop_front();
+		if (touched_set_.erase(node) != 0)
+			return node;
+	}
+
+	return nullptr;
+}
+
 }
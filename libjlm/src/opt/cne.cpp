@@ -32,7 +32,7 @@ public:
 	void
 	start_mark_stat(const jive::graph & graph) noexcept
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		ninputs_before_ = jive::ninputs(graph.root());
 		marktimer_.start();
 	}
@@ -52,7 +52,7 @@ public:
 	void
 	end_divert_stat(const jive::graph & graph) noexcept
 	{
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 		ninputs_after_ = jive::ninputs(graph.root());
 		diverttimer_.stop();
 	}
@@ -372,20 +372,20 @@ mark_delta(const jive::structural_node * node, cnectx & ctx)
 static void
 mark(const jive::structural_node * node, cnectx & ctx)
 {
-	static std::unordered_map<
-		std::type_index
-	, void(*)(const jive::structural_node*, cnectx&)
-	> map({
-	  {std::type_index(typeid(jive::gamma_op)), mark_gamma}
-	, {std::type_index(typeid(jive::theta_op)), mark_theta}
-	, {typeid(lambda::operation), mark_lambda}
-	, {typeid(jive::phi::operation), mark_phi}
-	, {typeid(delta::operation), mark_delta}
-	});
-
-	auto & op = node->operation();
-	JLM_ASSERT(map.find(typeid(op)) != map.end());
-	map[typeid(op)](node, ctx);
+	switch (get_opcode(node->operation())) {
+		case opcode::gamma_op:
+			return mark_gamma(node, ctx);
+		case opcode::theta_op:
+			return mark_theta(node, ctx);
+		case opcode::lambda:
+			return mark_lambda(node, ctx);
+		case opcode::phi:
+			return mark_phi(node, ctx);
+		case opcode::delta:
+			return mark_delta(node, ctx);
+		default:
+			JLM_UNREACHABLE("Unhandled structural node.");
+	}
 }
 
 static void
@@ -522,20 +522,20 @@ divert_delta(jive::structural_node * node, cnectx & ctx)
 static void
 divert(jive::structural_node * node, cnectx & ctx)
 {
-	static std::unordered_map<
-		std::type_index,
-		void(*)(jive::structural_node*, cnectx&)
-	> map({
-	  {std::type_index(typeid(jive::gamma_op)), divert_gamma}
-	, {std::type_index(typeid(jive::theta_op)), divert_theta}
-	, {typeid(lambda::operation), divert_lambda}
-	, {typeid(jive::phi::operation), divert_phi}
-	, {typeid(delta::operation), divert_delta}
-	});
-
-	auto & op = node->operation();
-	JLM_ASSERT(map.find(typeid(op)) != map.end());
-	map[typeid(op)](node, ctx);
+	switch (get_opcode(node->operation())) {
+		case opcode::gamma_op:
+			return divert_gamma(node, ctx);
+		case opcode::theta_op:
+			return divert_theta(node, ctx);
+		case opcode::lambda:
+			return divert_lambda(node, ctx);
+		case opcode::phi:
+			return divert_phi(node, ctx);
+		case opcode::delta:
+			return divert_delta(node, ctx);
+		default:
+			JLM_UNREACHABLE("Unhandled structural node.");
+	}
 }
 
 static void
@@ -557,16 +557,17 @@ cne(rvsdg_module & rm, const stats_descriptor & sd)
 	cnectx ctx;
 	cnestat stat;
 
-	stat.start_mark_stat(graph);
+	if (sd.print_cne_stat)
+		stat.start_mark_stat(graph);
 	mark(graph.root(), ctx);
 	stat.end_mark_stat();
 
 	stat.start_divert_stat();
 	divert(graph.root(), ctx);
-	stat.end_divert_stat(graph);
-
-	if (sd.print_cne_stat)
+	if (sd.print_cne_stat) {
+		stat.end_divert_stat(graph);
 		sd.print_stat(stat);
+	}
 }
 
 /* cne class */
@@ -0,0 +1,559 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/dae.hpp>
+#include <jlm/opt/inlining.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/phi.hpp>
+#include <jive/rvsdg/substitution.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/rvsdg/traverser.hpp>
+
+namespace jlm {
+
+class daestat final : public stat {
+public:
+	virtual
+	~daestat()
+	{}
+
+	daestat()
+	: nnodes_before_(0), nnodes_after_(0)
+	, ninputs_before_(0), ninputs_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		ninputs_before_ = jive::ninputs(graph.root());
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph) noexcept
+	{
+		nnodes_after_ = jlm::nnodes(graph);
+		ninputs_after_ = jive::ninputs(graph.root());
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("DAE ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			ninputs_before_, " ", ninputs_after_, " ",
+			timer_.ns()
+		);
+	}
+
+private:
+	size_t nnodes_before_, nnodes_after_;
+	size_t ninputs_before_, ninputs_after_;
+	jlm::timer timer_;
+};
+
+/* signature */
+
+/*
+	The reduced signature of a lambda. It records the indices of the function arguments and
+	results that are kept, as well as the resulting function type.
+*/
+class signature final {
+public:
+	signature(
+		const lambda::node & lambda,
+		std::vector<size_t> arguments,
+		std::vector<size_t> results)
+	: arguments_(std::move(arguments))
+	, results_(std::move(results))
+	, type_(create_type(lambda.type(), arguments_, results_))
+	{}
+
+	const std::vector<size_t> &
+	arguments() const noexcept
+	{
+		return arguments_;
+	}
+
+	const std::vector<size_t> &
+	results() const noexcept
+	{
+		return results_;
+	}
+
+	const jive::fcttype &
+	type() const noexcept
+	{
+		return type_;
+	}
+
+private:
+	static jive::fcttype
+	create_type(
+		const jive::fcttype & type,
+		const std::vector<size_t> & arguments,
+		const std::vector<size_t> & results)
+	{
+		std::vector<const jive::type*> argument_types;
+		for (const auto & n : arguments)
+			argument_types.push_back(&type.argument_type(n));
+
+		std::vector<const jive::type*> result_types;
+		for (const auto & n : results)
+			result_types.push_back(&type.result_type(n));
+
+		return jive::fcttype(argument_types, result_types);
+	}
+
+	std::vector<size_t> arguments_;
+	std::vector<size_t> results_;
+	jive::fcttype type_;
+};
+
+typedef std::unordered_map<const lambda::node*, std::unique_ptr<signature>> signaturemap;
+
+static bool
+is_value(const jive::type & type)
+{
+	return dynamic_cast<const jive::valuetype*>(&type) != nullptr;
+}
+
+/*
+	Computes the reduced signature of a lambda. Only value typed arguments and results are
+	removed, and only if all users of the lambda are direct calls. Returns NULL if nothing can
+	be removed.
+*/
+static std::unique_ptr<signature>
+compute_signature(const lambda::node & lambda)
+{
+	std::vector<jive::simple_node*> calls;
+	if (!lambda.direct_calls(&calls) || calls.empty())
+		return nullptr;
+
+	/*
+		A call could reach the lambda through a merge of several functions. We can only rewrite
+		calls that unambiguously resolve to the lambda.
+	*/
+	for (const auto & call : calls) {
+		if (is_direct_call(*call) != &lambda)
+			return nullptr;
+	}
+
+	auto & type = lambda.type();
+
+	std::vector<size_t> arguments;
+	for (size_t n = 0; n < lambda.nfctarguments(); n++) {
+		auto argument = lambda.fctargument(n);
+		if (!is_value(argument->type()) || argument->nusers() != 0)
+			arguments.push_back(n);
+	}
+
+	std::vector<size_t> results;
+	for (size_t n = 0; n < lambda.nfctresults(); n++) {
+		bool dead = is_value(type.result_type(n));
+		for (const auto & call : calls)
+			dead = dead && call->output(n)->nusers() == 0;
+
+		if (!dead)
+			results.push_back(n);
+	}
+
+	if (arguments.size() == lambda.nfctarguments() && results.size() == lambda.nfctresults())
+		return nullptr;
+
+	return std::make_unique<signature>(lambda, std::move(arguments), std::move(results));
+}
+
+/* copy with reduced signatures */
+
+/*
+	The copy functions below mirror the copy() methods of the nodes, but rebuild structural nodes
+	from their origins instead of their operations. This permits the types of function pointers
+	that are routed through a node to change, which is necessary when the lambdas of a phi region
+	are reduced and their recursion variables change type.
+*/
+
+static void
+copy_region(
+	jive::region * source,
+	jive::region * target,
+	jive::substitution_map & smap,
+	const signaturemap & sigmap);
+
+static lambda::node *
+copy_lambda(
+	const lambda::node & lambda,
+	jive::region * target,
+	jive::substitution_map & smap,
+	const signaturemap & sigmap)
+{
+	auto it = sigmap.find(&lambda);
+	auto sig = it != sigmap.end() ? it->second.get() : nullptr;
+	auto & type = sig ? sig->type() : lambda.type();
+
+	auto nlambda = lambda::node::create(target, type, lambda.name(), lambda.linkage(),
+		lambda.attributes());
+
+	/* add context variables */
+	jive::substitution_map subregionmap;
+	for (auto & cv : lambda.ctxvars())
+		subregionmap.insert(cv.argument(), nlambda->add_ctxvar(smap.lookup(cv.origin())));
+
+	/* map function arguments */
+	for (size_t n = 0; n < nlambda->nfctarguments(); n++) {
+		auto argument = lambda.fctargument(sig ? sig->arguments()[n] : n);
+		nlambda->fctargument(n)->set_attributes(argument->attributes());
+		subregionmap.insert(argument, nlambda->fctargument(n));
+	}
+
+	copy_region(lambda.subregion(), nlambda->subregion(), subregionmap, sigmap);
+
+	/* collect function results */
+	std::vector<jive::output*> results;
+	for (size_t n = 0; n < type.nresults(); n++) {
+		auto result = lambda.subregion()->result(sig ? sig->results()[n] : n);
+		results.push_back(subregionmap.lookup(result->origin()));
+	}
+
+	auto output = nlambda->finalize(results);
+	smap.insert(lambda.output(), output);
+
+	return nlambda;
+}
+
+static void
+copy_lambda(
+	const jive::structural_node & node,
+	jive::region * target,
+	jive::substitution_map & smap,
+	const signaturemap & sigmap)
+{
+	copy_lambda(*static_cast<const lambda::node*>(&node), target, smap, sigmap);
+}
+
+static void
+copy_gamma(
+	const jive::structural_node & node,
+	jive::region * target,
+	jive::substitution_map & smap,
+	const signaturemap & sigmap)
+{
+	auto gamma = static_cast<const jive::gamma_node*>(&node);
+	auto predicate = smap.lookup(gamma->predicate()->origin());
+	auto ngamma = jive::gamma_node::create(predicate, gamma->nsubregions());
+
+	/* add entry variables */
+	std::vector<jive::substitution_map> rmap(gamma->nsubregions());
+	for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++) {
+		auto nev = ngamma->add_entryvar(smap.lookup(ev->origin()));
+		for (size_t n = 0; n < nev->narguments(); n++)
+			rmap[n].insert(ev->argument(n), nev->argument(n));
+	}
+
+	for (size_t n = 0; n < gamma->nsubregions(); n++)
+		copy_region(gamma->subregion(n), ngamma->subregion(n), rmap[n], sigmap);
+
+	/* add exit variables */
+	for (size_t n = 0; n < gamma->noutputs(); n++) {
+		std::vector<jive::output*> operands;
+		for (size_t r = 0; r < gamma->nsubregions(); r++)
+			operands.push_back(rmap[r].lookup(gamma->subregion(r)->result(n)->origin()));
+
+		smap.insert(gamma->output(n), ngamma->add_exitvar(operands));
+	}
+}
+
+static void
+copy_theta(
+	const jive::structural_node & node,
+	jive::region * target,
+	jive::substitution_map & smap,
+	const signaturemap & sigmap)
+{
+	auto theta = static_cast<const jive::theta_node*>(&node);
+	auto ntheta = jive::theta_node::create(target);
+
+	/* add loop variables */
+	jive::substitution_map rmap;
+	std::vector<std::pair<jive::theta_output*, jive::theta_output*>> loopvars;
+	for (const auto & olv : *theta) {
+		auto nlv = ntheta->add_loopvar(smap.lookup(olv->input()->origin()));
+		rmap.insert(olv->argument(), nlv->argument());
+		loopvars.push_back({olv, nlv});
+	}
+
+	copy_region(theta->subregion(), ntheta->subregion(), rmap, sigmap);
+
+	ntheta->set_predicate(rmap.lookup(theta->predicate()->origin()));
+	for (const auto & lv : loopvars) {
+		lv.second->result()->divert_to(rmap.lookup(lv.first->result()->origin()));
+		smap.insert(lv.first, lv.second);
+	}
+}
+
+/*
+	Creates a call with the reduced signature \p sig in the region of \p function.
+*/
+static std::vector<jive::output*>
+create_call(
+	jive::output * function,
+	const std::vector<jive::output*> & operands,
+	const signature & sig)
+{
+	std::vector<jive::output*> arguments;
+	for (const auto & n : sig.arguments())
+		arguments.push_back(operands[n]);
+
+	return call_op::create(function, arguments);
+}
+
+static void
+copy_call(
+	const jive::simple_node & call,
+	const signature & sig,
+	jive::substitution_map & smap)
+{
+	std::vector<jive::output*> operands;
+	for (size_t n = 1; n < call.ninputs(); n++)
+		operands.push_back(smap.lookup(call.input(n)->origin()));
+
+	auto function = smap.lookup(call.input(0)->origin());
+	auto results = create_call(function, operands, sig);
+
+	for (size_t n = 0; n < sig.results().size(); n++)
+		smap.insert(call.output(sig.results()[n]), results[n]);
+}
+
+static void
+copy_region(
+	jive::region * source,
+	jive::region * target,
+	jive::substitution_map & smap,
+	const signaturemap & sigmap)
+{
+	for (const auto & node : jive::topdown_traverser(source)) {
+		if (auto simple = dynamic_cast<const jive::simple_node*>(node)) {
+			auto lambda = is_direct_call(*simple);
+			auto it = lambda ? sigmap.find(lambda) : sigmap.end();
+			if (it != sigmap.end()) {
+				copy_call(*simple, *it->second, smap);
+				continue;
+			}
+		}
+
+		auto structnode = static_cast<const jive::structural_node*>(node);
+		switch (get_opcode(node->operation())) {
+			case opcode::lambda:
+				copy_lambda(*structnode, target, smap, sigmap);
+				break;
+			case opcode::gamma_op:
+				copy_gamma(*structnode, target, smap, sigmap);
+				break;
+			case opcode::theta_op:
+				copy_theta(*structnode, target, smap, sigmap);
+				break;
+			default:
+				node->copy(target, smap);
+		}
+	}
+}
+
+/* dead argument elimination */
+
+/*
+	Replaces \p call with a call to \p function, which is the reduced lambda. The function is
+	routed into the region of \p call.
+*/
+static void
+reroute_call(
+	jive::simple_node * call,
+	jive::output * function,
+	const signature & sig)
+{
+	std::vector<jive::output*> operands;
+	for (size_t n = 1; n < call->ninputs(); n++)
+		operands.push_back(call->input(n)->origin());
+
+	function = route_to_region(function, call->region());
+	auto results = create_call(function, operands, sig);
+
+	for (size_t n = 0; n < sig.results().size(); n++)
+		call->output(sig.results()[n])->divert_users(results[n]);
+
+	remove(call);
+}
+
+static bool
+is_nested(const jive::region * region, const jive::structural_node * node)
+{
+	while (region->node() != nullptr) {
+		if (region->node() == node)
+			return true;
+
+		region = region->node()->region();
+	}
+
+	return false;
+}
+
+static void
+reduce_lambda(const lambda::node & lambda)
+{
+	auto sig = compute_signature(lambda);
+	if (!sig)
+		return;
+
+	std::vector<jive::simple_node*> calls;
+	lambda.direct_calls(&calls);
+
+	jive::substitution_map smap;
+	for (auto & cv : lambda.ctxvars())
+		smap.insert(cv.origin(), cv.origin());
+
+	signaturemap sigmap;
+	auto & s = *sig;
+	sigmap[&lambda] = std::move(sig);
+
+	auto nlambda = copy_lambda(lambda, lambda.region(), smap, sigmap);
+
+	for (const auto & call : calls)
+		reroute_call(call, nlambda->output(), s);
+}
+
+static void
+reduce_phi(const jive::structural_node & phi)
+{
+	auto subregion = phi.subregion(0);
+
+	signaturemap sigmap;
+	std::unordered_map<const lambda::node*, std::vector<jive::simple_node*>> calls;
+	for (const auto & node : subregion->nodes) {
+		auto lambda = dynamic_cast<const lambda::node*>(&node);
+		if (!lambda)
+			continue;
+
+		if (auto sig = compute_signature(*lambda)) {
+			/* Calls within the phi region are rewritten while copying it. */
+			std::vector<jive::simple_node*> lambdacalls;
+			lambda->direct_calls(&lambdacalls);
+			for (const auto & call : lambdacalls) {
+				if (!is_nested(call->region(), &phi))
+					calls[lambda].push_back(call);
+			}
+
+			sigmap[lambda] = std::move(sig);
+		}
+	}
+
+	if (sigmap.empty())
+		return;
+
+	jive::phi::builder pb;
+	pb.begin(phi.region());
+
+	/*
+		FIXME: This assumes that all recursion variables where added before the dependencies.
+	*/
+	jive::substitution_map smap;
+	std::vector<jive::phi::rvoutput*> rvs;
+	for (size_t n = 0; n < subregion->nresults(); n++) {
+		auto origin = subregion->result(n)->origin();
+		auto lambda = dynamic_cast<const lambda::node*>(jive::node_output::node(origin));
+		auto it = lambda ? sigmap.find(lambda) : sigmap.end();
+
+		auto rv = it != sigmap.end()
+		        ? pb.add_recvar(ptrtype(it->second->type()))
+		        : pb.add_recvar(subregion->argument(n)->type());
+		smap.insert(subregion->argument(n), rv->argument());
+		rvs.push_back(rv);
+	}
+
+	for (size_t n = 0; n < phi.ninputs(); n++) {
+		auto input = phi.input(n);
+		smap.insert(input->arguments.first(), pb.add_ctxvar(input->origin()));
+	}
+
+	copy_region(subregion, pb.subregion(), smap, sigmap);
+
+	for (size_t n = 0; n < rvs.size(); n++)
+		rvs[n]->set_rvorigin(smap.lookup(subregion->result(n)->origin()));
+	auto nphi = pb.end();
+
+	/*
+		Divert the users of unchanged recursion variables and reroute the remaining direct calls.
+		The old phi node is left for dead node elimination.
+	*/
+	for (size_t n = 0; n < phi.noutputs(); n++) {
+		auto origin = subregion->result(n)->origin();
+		auto lambda = dynamic_cast<const lambda::node*>(jive::node_output::node(origin));
+		auto it = lambda ? sigmap.find(lambda) : sigmap.end();
+
+		if (it == sigmap.end()) {
+			phi.output(n)->divert_users(nphi->output(n));
+			continue;
+		}
+
+		for (const auto & call : calls[lambda])
+			reroute_call(call, nphi->output(n), *it->second);
+	}
+}
+
+static void
+dae(jive::region * region)
+{
+	/*
+		Collect the nodes first, since the transformation adds new nodes to the region.
+	*/
+	std::vector<const jive::structural_node*> nodes;
+	for (const auto & node : jive::topdown_traverser(region)) {
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(node))
+			nodes.push_back(structnode);
+	}
+
+	for (const auto & node : nodes) {
+		if (auto lambda = dynamic_cast<const lambda::node*>(node)) {
+			reduce_lambda(*lambda);
+		} else if (is<jive::phi::operation>(node)) {
+			reduce_phi(*node);
+		}
+	}
+}
+
+static void
+dae(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	daestat stat;
+	if (sd.print_dae_stat)
+		stat.start(graph);
+	dae(graph.root());
+	if (sd.print_dae_stat) {
+		stat.end(graph);
+		sd.print_stat(stat);
+	}
+}
+
+/* dae class */
+
+dae::~dae()
+{}
+
+void
+dae::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	jlm::dae(module, sd);
+}
+
+}
@@ -0,0 +1,317 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/devirtualization.hpp>
+#include <jlm/opt/inlining.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/phi.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/rvsdg/traverser.hpp>
+
+#include <algorithm>
+
+namespace jlm {
+
+class dvtstat final : public stat {
+public:
+	virtual
+	~dvtstat()
+	{}
+
+	dvtstat()
+	: ncalls_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t ncalls) noexcept
+	{
+		ncalls_ = ncalls;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("DVT ", nnodes_before_, " ", nnodes_after_, " ", ncalls_, " ", timer_.ns());
+	}
+
+private:
+	size_t ncalls_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/*
+	Follows \p output through context variables, entry variables, invariant loop variables, and
+	recursion variables to its producer. Returns NULL if the output is a variant loop variable.
+*/
+static const jive::output *
+trace(const jive::output * output)
+{
+	while (true) {
+		if (is<lambda::cvargument>(output)
+		|| is<delta::cvargument>(output)
+		|| is_gamma_argument(output)
+		|| is_phi_cv(output)) {
+			output = static_cast<const jive::argument*>(output)->input()->origin();
+			continue;
+		}
+
+		if (auto argument = is_theta_argument(output)) {
+			auto loopvar = static_cast<const jive::theta_input*>(argument->input())->output();
+			if (loopvar->result()->origin() != argument)
+				return nullptr;
+
+			output = argument->input()->origin();
+			continue;
+		}
+
+		if (auto loopvar = is_theta_output(output)) {
+			if (loopvar->result()->origin() != loopvar->argument())
+				return nullptr;
+
+			output = loopvar->input()->origin();
+			continue;
+		}
+
+		if (is_phi_recvar_argument(output)) {
+			/*
+				FIXME: This assumes that all recursion variables where added before the dependencies.
+			*/
+			output = output->region()->result(output->index())->origin();
+			continue;
+		}
+
+		if (auto rvoutput = dynamic_cast<const jive::phi::rvoutput*>(output)) {
+			output = rvoutput->result()->origin();
+			continue;
+		}
+
+		return output;
+	}
+}
+
+static bool
+collect_targets(const jive::output * output, std::vector<lambda::node*> & targets);
+
+/*
+	Collects the targets of a function pointer that is loaded from \p address. The address must
+	point to a constant delta that is either initialized with a function or a table of functions.
+*/
+static bool
+collect_table_targets(const jive::output * address, std::vector<lambda::node*> & targets)
+{
+	auto node = jive::node_output::node(address);
+	if (is<getelementptr_op>(node))
+		address = node->input(0)->origin();
+
+	address = trace(address);
+	if (!dynamic_cast<const delta::output*>(address))
+		return false;
+
+	auto delta = static_cast<const delta::output*>(address)->node();
+	if (!delta->constant())
+		return false;
+
+	auto value = delta->result()->origin();
+	node = jive::node_output::node(value);
+	if (!is<ConstantArray>(node))
+		return collect_targets(value, targets);
+
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		if (!collect_targets(node->input(n)->origin(), targets))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	Collects all lambdas that \p output can evaluate to. Returns false if not all targets could
+	be determined.
+*/
+static bool
+collect_targets(const jive::output * output, std::vector<lambda::node*> & targets)
+{
+	output = trace(output);
+	if (output == nullptr)
+		return false;
+
+	if (auto o = dynamic_cast<const lambda::output*>(output)) {
+		if (std::find(targets.begin(), targets.end(), o->node()) == targets.end())
+			targets.push_back(o->node());
+		return true;
+	}
+
+	if (auto gamma_output = is_gamma_output(output)) {
+		for (size_t n = 0; n < gamma_output->nresults(); n++) {
+			if (!collect_targets(gamma_output->result(n)->origin(), targets))
+				return false;
+		}
+
+		return true;
+	}
+
+	auto node = jive::node_output::node(output);
+	if (is<select_op>(node)) {
+		return collect_targets(node->input(1)->origin(), targets)
+		    && collect_targets(node->input(2)->origin(), targets);
+	}
+
+	if (is<load_op>(node))
+		return collect_table_targets(node->input(0)->origin(), targets);
+
+	return false;
+}
+
+/*
+	Creates a call of the function \p operands[0] with the arguments \p operands[1:] in
+	\p region that dispatches directly to \p targets[n:]. The last target is called without a
+	comparison, as the target set is complete.
+*/
+static std::vector<jive::output*>
+create_dispatch(
+	jive::region * region,
+	const std::vector<jive::output*> & operands,
+	const std::vector<lambda::node*> & targets,
+	size_t n)
+{
+	JLM_ASSERT(n < targets.size());
+
+	auto target = route_to_region(targets[n]->output(), region);
+	std::vector<jive::output*> arguments(std::next(operands.begin()), operands.end());
+	if (n == targets.size()-1)
+		return call_op::create(target, arguments);
+
+	auto & type = *static_cast<const ptrtype*>(&operands[0]->type());
+	ptrcmp_op op(type, cmp::eq);
+	auto cmp = jive::simple_node::create_normalized(region, op, {operands[0], target})[0];
+	auto predicate = jive::match(1, {{1, 1}}, 0, 2, cmp);
+	auto gamma = jive::gamma_node::create(predicate, 2);
+
+	std::vector<jive::output*> operands0, arguments1;
+	for (size_t i = 0; i < operands.size(); i++) {
+		auto ev = gamma->add_entryvar(operands[i]);
+		operands0.push_back(ev->argument(0));
+		if (i != 0)
+			arguments1.push_back(ev->argument(1));
+	}
+	auto ev = gamma->add_entryvar(target);
+
+	auto results0 = create_dispatch(gamma->subregion(0), operands0, targets, n+1);
+	auto results1 = call_op::create(ev->argument(1), arguments1);
+
+	std::vector<jive::output*> results;
+	for (size_t i = 0; i < results0.size(); i++)
+		results.push_back(gamma->add_exitvar({results0[i], results1[i]}));
+
+	return results;
+}
+
+static void
+promote(jive::simple_node * call, const std::vector<lambda::node*> & targets)
+{
+	std::vector<jive::output*> operands;
+	for (size_t n = 0; n < call->ninputs(); n++)
+		operands.push_back(call->input(n)->origin());
+
+	auto results = create_dispatch(call->region(), operands, targets, 0);
+	for (size_t n = 0; n < call->noutputs(); n++)
+		call->output(n)->divert_users(results[n]);
+
+	remove(call);
+}
+
+static void
+collect_calls(jive::region * region, std::vector<jive::simple_node*> & calls)
+{
+	for (const auto & node : jive::topdown_traverser(region)) {
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_calls(structnode->subregion(n), calls);
+			continue;
+		}
+
+		if (is<call_op>(node))
+			calls.push_back(static_cast<jive::simple_node*>(node));
+	}
+}
+
+static size_t
+devirtualize(jive::region * region, size_t ntargets)
+{
+	/*
+		Collect the calls first, since the promotion adds new calls.
+	*/
+	std::vector<jive::simple_node*> calls;
+	collect_calls(region, calls);
+
+	size_t ncalls = 0;
+	for (const auto & call : calls) {
+		if (is_direct_call(*call))
+			continue;
+
+		std::vector<lambda::node*> targets;
+		if (!collect_targets(call->input(0)->origin(), targets)
+		|| targets.empty()
+		|| targets.size() > ntargets)
+			continue;
+
+		auto & type = call->input(0)->type();
+		if (std::any_of(targets.begin(), targets.end(), [&](const lambda::node * target) {
+			return target->output()->type() != type;
+		}))
+			continue;
+
+		promote(call, targets);
+		ncalls++;
+	}
+
+	return ncalls;
+}
+
+static void
+devirtualize(rvsdg_module & rm, const stats_descriptor & sd, size_t ntargets)
+{
+	auto & graph = *rm.graph();
+
+	dvtstat stat;
+	stat.start(graph);
+	auto ncalls = devirtualize(graph.root(), ntargets);
+	stat.end(graph, ncalls);
+
+	if (sd.print_devirtualization_stat)
+		sd.print_stat(stat);
+}
+
+/* devirtualization class */
+
+devirtualization::~devirtualization()
+{}
+
+void
+devirtualization::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	devirtualize(module, sd, ntargets_);
+}
+
+}
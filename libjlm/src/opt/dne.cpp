@@ -35,7 +35,7 @@ public:
 	void
 	start_mark_stat(const jive::graph & graph) noexcept
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		ninputs_before_ = jive::ninputs(graph.root());
 		marktimer_.start();
 	}
@@ -55,7 +55,7 @@ public:
 	void
 	end_sweep_stat(const jive::graph & graph) noexcept
 	{
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 		ninputs_after_ = jive::ninputs(graph.root());
 		sweeptimer_.stop();
 	}
@@ -351,20 +351,20 @@ sweep_gamma(jive::structural_node * node, const dnectx & ctx)
 static void
 sweep(jive::structural_node * node, const dnectx & ctx)
 {
-	static std::unordered_map<
-		std::type_index
-	, void(*)(jive::structural_node*, const dnectx&)
-	> map({
-	  {std::type_index(typeid(jive::gamma_op)), sweep_gamma}
-	, {std::type_index(typeid(jive::theta_op)), sweep_theta}
-	, {typeid(lambda::operation), sweep_lambda}
-	, {typeid(jive::phi::operation), sweep_phi}
-	, {typeid(delta::operation), sweep_delta}
-	});
-
-	auto & op = node->operation();
-	JLM_ASSERT(map.find(typeid(op)) != map.end());
-	map[typeid(op)](node, ctx);
+	switch (get_opcode(node->operation())) {
+		case opcode::gamma_op:
+			return sweep_gamma(node, ctx);
+		case opcode::theta_op:
+			return sweep_theta(node, ctx);
+		case opcode::lambda:
+			return sweep_lambda(node, ctx);
+		case opcode::phi:
+			return sweep_phi(node, ctx);
+		case opcode::delta:
+			return sweep_delta(node, ctx);
+		default:
+			JLM_UNREACHABLE("Unhandled structural node.");
+	}
 }
 
 static void
@@ -411,16 +411,17 @@ dne(rvsdg_module & rm, const stats_descriptor & sd)
 	dnectx ctx;
 	dnestat ds;
 
-	ds.start_mark_stat(graph);
+	if (sd.print_dne_stat)
+		ds.start_mark_stat(graph);
 	mark(*graph.root(), ctx);
 	ds.end_mark_stat();
 
 	ds.start_sweep_stat();
 	sweep(graph, ctx);
-	ds.end_sweep_stat(graph);
-
-	if (sd.print_dne_stat)
+	if (sd.print_dne_stat) {
+		ds.end_sweep_stat(graph);
 		sd.print_stat(ds);
+	}
 }
 
 /* dne class */
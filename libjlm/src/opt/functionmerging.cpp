@@ -0,0 +1,397 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/functionmerging.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/traverser.hpp>
+
+namespace jlm {
+
+class fmgstat final : public stat {
+public:
+	virtual
+	~fmgstat()
+	{}
+
+	fmgstat()
+	: nmerged_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nmerged) noexcept
+	{
+		nmerged_ = nmerged;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("FMG ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			nmerged_, " ",
+			timer_.ns()
+		);
+	}
+
+private:
+	size_t nmerged_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/* structural hashing */
+
+static size_t
+hash(const jive::region * region)
+{
+	size_t h = region->narguments() * 31 + region->nresults();
+	for (const auto & node : region->nodes) {
+		size_t nh = jlm::hash(node.operation());
+		for (size_t n = 0; n < node.ninputs(); n++) {
+			auto origin = node.input(n)->origin();
+			nh = nh * 31 + origin->index() * 2 + (dynamic_cast<const jive::argument*>(origin) != nullptr);
+		}
+
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				nh = nh * 31 + hash(structnode->subregion(n));
+		}
+
+		/* nodes are summed up such that the hash is independent of the node order */
+		h += nh;
+	}
+
+	return h;
+}
+
+static size_t
+hash(const lambda::node * lambda)
+{
+	size_t h = std::hash<std::string>()(lambda->type().debug_string());
+	for (const auto & cv : lambda->ctxvars())
+		h += std::hash<const jive::output*>()(cv.origin());
+
+	return h * 31 + hash(lambda->subregion());
+}
+
+/* equivalence verification */
+
+/*
+	Verifies that two lambdas compute the same function. Two outputs are equivalent if they are
+	function arguments with the same index, context variables with the same origin, arguments of
+	corresponding subregions with the same index, or the same outputs of equivalent nodes. The
+	mappings between the nodes and outputs of both lambdas must be one-to-one.
+*/
+class congruence final {
+public:
+	congruence(const lambda::node * l1, const lambda::node * l2)
+	: l1_(l1)
+	, l2_(l2)
+	{}
+
+	bool
+	equivalent()
+	{
+		if (l1_->type() != l2_->type() || !(l1_->attributes() == l2_->attributes()))
+			return false;
+
+		regions_[l1_->subregion()] = l2_->subregion();
+		return equivalent(l1_->subregion(), l2_->subregion());
+	}
+
+private:
+	bool
+	equivalent(const jive::region * r1, const jive::region * r2)
+	{
+		if (r1->narguments() != r2->narguments() || r1->nresults() != r2->nresults())
+			return false;
+
+		for (size_t n = 0; n < r1->nresults(); n++) {
+			if (!equivalent(r1->result(n)->origin(), r2->result(n)->origin()))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool
+	equivalent(const jive::output * o1, const jive::output * o2)
+	{
+		auto it = outputs_.find(o1);
+		if (it != outputs_.end())
+			return it->second == o2;
+
+		if (o1->type() != o2->type())
+			return false;
+
+		auto a1 = dynamic_cast<const jive::argument*>(o1);
+		auto a2 = dynamic_cast<const jive::argument*>(o2);
+		if (a1 || a2) {
+			if (!a1 || !a2 || !equivalent(a1, a2))
+				return false;
+
+			return map(o1, o2, outputs_, routputs_);
+		}
+
+		if (o1->index() != o2->index()
+		|| !equivalent(jive::node_output::node(o1), jive::node_output::node(o2)))
+			return false;
+
+		return map(o1, o2, outputs_, routputs_);
+	}
+
+	bool
+	equivalent(const jive::argument * a1, const jive::argument * a2)
+	{
+		auto it = regions_.find(a1->region());
+		if (it == regions_.end() || it->second != a2->region())
+			return false;
+
+		auto cv1 = dynamic_cast<const lambda::cvargument*>(a1);
+		auto cv2 = dynamic_cast<const lambda::cvargument*>(a2);
+		if (a1->region() == l1_->subregion() && (cv1 || cv2))
+			return cv1 && cv2 && cv1->input()->origin() == cv2->input()->origin();
+
+		return a1->index() == a2->index();
+	}
+
+	bool
+	equivalent(const jive::node * n1, const jive::node * n2)
+	{
+		auto it = nodes_.find(n1);
+		if (it != nodes_.end())
+			return it->second == n2;
+
+		if (!(n1->operation() == n2->operation())
+		|| n1->ninputs() != n2->ninputs()
+		|| n1->noutputs() != n2->noutputs())
+			return false;
+
+		for (size_t n = 0; n < n1->ninputs(); n++) {
+			if (!equivalent(n1->input(n)->origin(), n2->input(n)->origin()))
+				return false;
+		}
+
+		if (auto s1 = dynamic_cast<const jive::structural_node*>(n1)) {
+			auto s2 = static_cast<const jive::structural_node*>(n2);
+			if (s1->nsubregions() != s2->nsubregions())
+				return false;
+
+			for (size_t n = 0; n < s1->nsubregions(); n++) {
+				regions_[s1->subregion(n)] = s2->subregion(n);
+				if (!equivalent(s1->subregion(n), s2->subregion(n)))
+					return false;
+			}
+		}
+
+		return map(n1, n2, nodes_, rnodes_);
+	}
+
+	/*
+		Maps \p x1 to \p x2 unless \p x2 is already mapped from another element.
+	*/
+	template<class T> static bool
+	map(
+		const T * x1,
+		const T * x2,
+		std::unordered_map<const T*, const T*> & forward,
+		std::unordered_map<const T*, const T*> & backward)
+	{
+		auto it = backward.find(x2);
+		if (it != backward.end() && it->second != x1)
+			return false;
+
+		forward[x1] = x2;
+		backward[x2] = x1;
+		return true;
+	}
+
+	const lambda::node * l1_;
+	const lambda::node * l2_;
+	std::unordered_map<const jive::node*, const jive::node*> nodes_;
+	std::unordered_map<const jive::node*, const jive::node*> rnodes_;
+	std::unordered_map<const jive::output*, const jive::output*> outputs_;
+	std::unordered_map<const jive::output*, const jive::output*> routputs_;
+	std::unordered_map<const jive::region*, const jive::region*> regions_;
+};
+
+static bool
+equivalent(const lambda::node * l1, const lambda::node * l2)
+{
+	congruence c(l1, l2);
+	return c.equivalent();
+}
+
+/* merging */
+
+/*
+	Returns true if \p output is only used as the function operand of calls, i.e., the address of
+	the lambda is never taken.
+*/
+static bool
+is_only_called(const jive::output * output)
+{
+	for (const auto & user : *output) {
+		if (auto cv = dynamic_cast<const lambda::cvinput*>(user)) {
+			if (!is_only_called(cv->argument()))
+				return false;
+			continue;
+		}
+
+		if (is<call_op>(input_node(user)) && user->index() == 0)
+			continue;
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+	Creates a lambda with the same signature, name, and linkage as \p lambda that forwards all
+	its arguments to \p canonical.
+*/
+static jive::output *
+create_forwarder(const lambda::node * lambda, const lambda::node * canonical)
+{
+	auto forwarder = lambda::node::create(lambda->region(), lambda->type(), lambda->name(),
+		lambda->linkage(), lambda->attributes());
+	auto function = forwarder->add_ctxvar(canonical->output());
+
+	std::vector<jive::output*> arguments;
+	for (size_t n = 0; n < forwarder->nfctarguments(); n++)
+		arguments.push_back(forwarder->fctargument(n));
+
+	auto results = call_op::create(function, arguments);
+	return forwarder->finalize(results);
+}
+
+static void
+merge(
+	const std::vector<lambda::node*> & lambdas,
+	std::unordered_set<const lambda::node*> & forwarders)
+{
+	JLM_ASSERT(lambdas.size() > 1);
+
+	auto canonical = lambdas[0];
+	for (const auto & lambda : lambdas) {
+		if (lambda->linkage() == linkage::internal_linkage) {
+			canonical = lambda;
+			break;
+		}
+	}
+
+	for (const auto & lambda : lambdas) {
+		if (lambda == canonical)
+			continue;
+
+		if (lambda->linkage() == linkage::internal_linkage && is_only_called(lambda->output()))
+			lambda->output()->divert_users(canonical->output());
+		else {
+			auto output = create_forwarder(lambda, canonical);
+			forwarders.insert(static_cast<const lambda::node*>(jive::node_output::node(output)));
+			lambda->output()->divert_users(output);
+		}
+
+		remove(lambda);
+	}
+}
+
+static size_t
+merge(jive::region * region, std::unordered_set<const lambda::node*> & forwarders)
+{
+	std::unordered_map<size_t, std::vector<lambda::node*>> buckets;
+	for (auto & node : jive::topdown_traverser(region)) {
+		auto lambda = dynamic_cast<lambda::node*>(node);
+		if (lambda && forwarders.find(lambda) == forwarders.end())
+			buckets[hash(lambda)].push_back(lambda);
+	}
+
+	std::vector<std::vector<lambda::node*>> classes;
+	for (const auto & bucket : buckets) {
+		if (bucket.second.size() < 2)
+			continue;
+
+		size_t first = classes.size();
+		for (const auto & lambda : bucket.second) {
+			size_t n = first;
+			for (; n < classes.size(); n++) {
+				if (equivalent(classes[n][0], lambda)) {
+					classes[n].push_back(lambda);
+					break;
+				}
+			}
+
+			if (n == classes.size())
+				classes.push_back({lambda});
+		}
+	}
+
+	size_t nmerged = 0;
+	for (const auto & lambdas : classes) {
+		if (lambdas.size() < 2)
+			continue;
+
+		merge(lambdas, forwarders);
+		nmerged += lambdas.size() - 1;
+	}
+
+	return nmerged;
+}
+
+static void
+merge(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	fmgstat stat;
+	stat.start(graph);
+
+	/*
+		Merging redirects context variables of other lambdas, which might render them identical.
+		Iterate until no further lambdas are merged. Forwarders are excluded from merging as they
+		would otherwise only be replaced by chains of forwarders.
+	*/
+	size_t nmerged = 0, n;
+	std::unordered_set<const lambda::node*> forwarders;
+	do {
+		n = merge(graph.root(), forwarders);
+		nmerged += n;
+	} while (n != 0);
+
+	stat.end(graph, nmerged);
+
+	if (sd.print_functionmerging_stat)
+		sd.print_stat(stat);
+}
+
+/* functionmerging class */
+
+functionmerging::~functionmerging()
+{}
+
+void
+functionmerging::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	merge(module, sd);
+}
+
+}
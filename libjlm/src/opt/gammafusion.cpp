@@ -0,0 +1,341 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/gammafusion.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/substitution.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace jlm {
+
+class gfsstat final : public stat {
+public:
+	virtual
+	~gfsstat()
+	{}
+
+	gfsstat()
+	: nfused_(0)
+	, nthreaded_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nfused, size_t nthreaded) noexcept
+	{
+		nfused_ = nfused;
+		nthreaded_ = nthreaded;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("GFS ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			nfused_, " ", nthreaded_, " ",
+			timer_.ns()
+		);
+	}
+
+private:
+	size_t nfused_;
+	size_t nthreaded_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/*
+	Two predicates are congruent if they are the same value, or if they are computed by
+	equivalent simple operations from the same operands.
+*/
+static bool
+congruent(jive::output * p1, jive::output * p2)
+{
+	if (p1 == p2)
+		return true;
+
+	auto n1 = dynamic_cast<jive::simple_node*>(jive::node_output::node(p1));
+	auto n2 = dynamic_cast<jive::simple_node*>(jive::node_output::node(p2));
+	if (n1 == nullptr || n2 == nullptr
+	|| n1->ninputs() != n2->ninputs()
+	|| p1->index() != p2->index()
+	|| n1->operation() != n2->operation())
+		return false;
+
+	for (size_t n = 0; n < n1->ninputs(); n++) {
+		if (n1->input(n)->origin() != n2->input(n)->origin())
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	Checks whether \p origin transitively depends on \p node. If \p direct is false, an output
+	of \p node itself is not considered a dependency.
+*/
+static bool
+depends_on(jive::output * origin, const jive::node * node, bool direct)
+{
+	if (!direct && jive::node_output::node(origin) == node)
+		return false;
+
+	std::unordered_set<jive::node*> visited;
+	std::vector<jive::output*> worklist({origin});
+	while (!worklist.empty()) {
+		auto producer = jive::node_output::node(worklist.back());
+		worklist.pop_back();
+
+		if (producer == node)
+			return true;
+
+		if (producer == nullptr || visited.find(producer) != visited.end())
+			continue;
+		visited.insert(producer);
+
+		for (size_t n = 0; n < producer->ninputs(); n++)
+			worklist.push_back(producer->input(n)->origin());
+	}
+
+	return false;
+}
+
+/*
+	Checks whether gamma \p g2 can be merged into gamma \p g1, i.e., whether no input of \p g2
+	depends on \p g1 other than directly through an output of \p g1.
+*/
+static bool
+is_mergeable(const jive::gamma_node * g1, const jive::gamma_node * g2)
+{
+	for (auto ev = g2->begin_entryvar(); ev != g2->end_entryvar(); ev++) {
+		if (depends_on(ev->origin(), g1, false))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	Returns the alternatives selected by \p predicate in each subregion of \p gamma if
+	\p predicate is an output of \p gamma that is a control constant in all subregions.
+*/
+static std::vector<size_t>
+selected_alternatives(const jive::gamma_node * gamma, const jive::output * predicate)
+{
+	std::vector<size_t> alternatives;
+	for (size_t n = 0; n < gamma->nsubregions(); n++) {
+		auto origin = gamma->subregion(n)->result(predicate->index())->origin();
+		auto node = jive::node_output::node(origin);
+		if (!is<jive::ctlconstant_op>(node))
+			return {};
+
+		auto op = static_cast<const jive::ctlconstant_op*>(&node->operation());
+		alternatives.push_back(op->value().alternative());
+	}
+
+	return alternatives;
+}
+
+/*
+	Merges gamma \p g2 into gamma \p g1. Subregion n of \p g1 receives a copy of subregion
+	alternatives[n] of \p g2. Inputs of \p g2 that are outputs of \p g1 are replaced by the
+	corresponding result origins in the subregions of \p g1.
+*/
+static void
+merge(jive::gamma_node * g1, jive::gamma_node * g2, const std::vector<size_t> & alternatives)
+{
+	JLM_ASSERT(alternatives.size() == g1->nsubregions());
+
+	std::unordered_map<jive::output*, std::vector<jive::output*>> entryvars;
+	for (auto ev = g1->begin_entryvar(); ev != g1->end_entryvar(); ev++) {
+		if (entryvars.find(ev->origin()) != entryvars.end())
+			continue;
+
+		for (size_t n = 0; n < g1->nsubregions(); n++)
+			entryvars[ev->origin()].push_back(ev->argument(n));
+	}
+
+	std::vector<jive::substitution_map> smap(g1->nsubregions());
+	for (auto ev = g2->begin_entryvar(); ev != g2->end_entryvar(); ev++) {
+		auto origin = ev->origin();
+		if (jive::node_output::node(origin) == g1) {
+			for (size_t n = 0; n < g1->nsubregions(); n++) {
+				auto subregion = g1->subregion(n);
+				smap[n].insert(ev->argument(alternatives[n]), subregion->result(origin->index())->origin());
+			}
+			continue;
+		}
+
+		if (entryvars.find(origin) == entryvars.end()) {
+			auto g1ev = g1->add_entryvar(origin);
+			for (size_t n = 0; n < g1->nsubregions(); n++)
+				entryvars[origin].push_back(g1ev->argument(n));
+		}
+
+		for (size_t n = 0; n < g1->nsubregions(); n++)
+			smap[n].insert(ev->argument(alternatives[n]), entryvars[origin][n]);
+	}
+
+	for (size_t n = 0; n < g1->nsubregions(); n++)
+		g2->subregion(alternatives[n])->copy(g1->subregion(n), smap[n], false, false);
+
+	for (size_t i = 0; i < g2->noutputs(); i++) {
+		std::vector<jive::output*> results;
+		for (size_t n = 0; n < g1->nsubregions(); n++) {
+			auto subregion = g2->subregion(alternatives[n]);
+			results.push_back(smap[n].lookup(subregion->result(i)->origin()));
+		}
+
+		auto xv = g1->add_exitvar(results);
+		g2->output(i)->divert_users(xv);
+	}
+
+	remove(g2);
+}
+
+/*
+	Tries to thread \p gamma into the gamma that produces its predicate.
+*/
+static bool
+thread(jive::gamma_node * gamma)
+{
+	auto predicate = gamma->predicate()->origin();
+	auto g1 = dynamic_cast<jive::gamma_node*>(jive::node_output::node(predicate));
+	if (g1 == nullptr)
+		return false;
+
+	auto alternatives = selected_alternatives(g1, predicate);
+	if (alternatives.empty() || !is_mergeable(g1, gamma))
+		return false;
+
+	merge(g1, gamma, alternatives);
+	return true;
+}
+
+/*
+	Tries to fuse \p gamma with another gamma of its region that has a congruent predicate.
+*/
+static bool
+fuse(jive::gamma_node * gamma)
+{
+	auto predicate = gamma->predicate()->origin();
+	for (auto & node : gamma->region()->nodes) {
+		auto other = dynamic_cast<jive::gamma_node*>(&node);
+		if (other == nullptr || other == gamma
+		|| other->nsubregions() != gamma->nsubregions()
+		|| !congruent(other->predicate()->origin(), predicate))
+			continue;
+
+		/*
+			One of the gammas might depend on the other one. The dependent gamma is merged into
+			the other one.
+		*/
+		auto g1 = other, g2 = gamma;
+		for (auto ev = g1->begin_entryvar(); ev != g1->end_entryvar(); ev++) {
+			if (depends_on(ev->origin(), g2, true)) {
+				std::swap(g1, g2);
+				break;
+			}
+		}
+
+		if (!is_mergeable(g1, g2))
+			continue;
+
+		std::vector<size_t> alternatives;
+		for (size_t n = 0; n < g1->nsubregions(); n++)
+			alternatives.push_back(n);
+
+		merge(g1, g2, alternatives);
+		return true;
+	}
+
+	return false;
+}
+
+static void
+fuse(jive::region * region, size_t & nfused, size_t & nthreaded)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				fuse(structnode->subregion(n), nfused, nthreaded);
+		}
+	}
+
+	/*
+		Every merge removes a gamma from the region. The gammas are therefore collected anew after
+		every merge.
+	*/
+	bool merged = true;
+	while (merged) {
+		merged = false;
+
+		std::vector<jive::gamma_node*> gammas;
+		for (auto & node : region->nodes) {
+			if (auto gamma = dynamic_cast<jive::gamma_node*>(&node))
+				gammas.push_back(gamma);
+		}
+
+		for (const auto & gamma : gammas) {
+			if (thread(gamma)) {
+				nthreaded++;
+				merged = true;
+				break;
+			}
+
+			if (fuse(gamma)) {
+				nfused++;
+				merged = true;
+				break;
+			}
+		}
+	}
+}
+
+static void
+gammafusion(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	size_t nfused = 0, nthreaded = 0;
+	gfsstat stat;
+	stat.start(graph);
+	fuse(graph.root(), nfused, nthreaded);
+	stat.end(graph, nfused, nthreaded);
+
+	if (sd.print_gammafusion_stat)
+		sd.print_stat(stat);
+}
+
+/* gammafusion class */
+
+gammafusion::~gammafusion()
+{}
+
+void
+gammafusion::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	jlm::gammafusion(module, sd);
+}
+
+}
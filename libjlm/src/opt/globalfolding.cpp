@@ -0,0 +1,356 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/globalfolding.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/substitution.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+namespace jlm {
+
+class glfstat final : public stat {
+public:
+	virtual
+	~glfstat()
+	{}
+
+	glfstat()
+	: nconstant_(0)
+	, nfolded_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nconstant, size_t nfolded) noexcept
+	{
+		nconstant_ = nconstant;
+		nfolded_ = nfolded;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("GLF ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			nconstant_, " ", nfolded_, " ",
+			timer_.ns()
+		);
+	}
+
+private:
+	size_t nconstant_;
+	size_t nfolded_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/* read-only analysis */
+
+/*
+	Returns true if the memory at \p address is only read, i.e., \p address is only used as the
+	address of loads, in pointer comparisons, and routed through getelementptrs, bitcasts, selects,
+	gammas, thetas, lambda and phi context variables to such uses.
+*/
+static bool
+is_readonly(
+	const jive::output * address,
+	std::unordered_set<const jive::output*> & visited)
+{
+	if (visited.find(address) != visited.end())
+		return true;
+	visited.insert(address);
+
+	for (const auto & user : *address) {
+		if (auto input = dynamic_cast<const jive::gamma_input*>(user)) {
+			for (size_t n = 0; n < input->narguments(); n++) {
+				if (!is_readonly(input->argument(n), visited))
+					return false;
+			}
+			continue;
+		}
+
+		if (auto input = dynamic_cast<const jive::theta_input*>(user)) {
+			if (!is_readonly(input->argument(), visited)
+			|| !is_readonly(input->output(), visited))
+				return false;
+			continue;
+		}
+
+		if (auto input = dynamic_cast<const lambda::cvinput*>(user)) {
+			if (!is_readonly(input->argument(), visited))
+				return false;
+			continue;
+		}
+
+		if (auto input = dynamic_cast<const jive::structural_input*>(user)) {
+			if (!is<jive::phi::operation>(input->node())
+			|| !is_readonly(input->arguments.first(), visited))
+				return false;
+			continue;
+		}
+
+		if (auto result = dynamic_cast<const jive::result*>(user)) {
+			auto node = result->region()->node();
+			if ((!is<jive::gamma_op>(node) && !is<jive::theta_op>(node))
+			|| !is_readonly(result->output(), visited))
+				return false;
+			continue;
+		}
+
+		auto node = input_node(user);
+		if (is<load_op>(node) && user->index() == 0)
+			continue;
+
+		if (is<ptrcmp_op>(node))
+			continue;
+
+		if ((is<getelementptr_op>(node) && user->index() == 0)
+		|| is<bitcast_op>(node)
+		|| (is<select_op>(node) && user->index() != 0)) {
+			if (!is_readonly(node->output(0), visited))
+				return false;
+			continue;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+static bool
+is_readonly(const delta::node * delta)
+{
+	if (delta->linkage() != linkage::internal_linkage)
+		return false;
+
+	std::unordered_set<const jive::output*> visited;
+	return is_readonly(delta->output(), visited);
+}
+
+/*
+	Replaces \p delta with an identical delta that is marked constant.
+*/
+static void
+make_constant(delta::node * delta)
+{
+	auto constant = delta::node::create(delta->region(), delta->type(), delta->name(),
+		delta->linkage(), true);
+
+	jive::substitution_map smap;
+	for (auto & cv : delta->ctxvars())
+		smap.insert(cv.argument(), constant->add_ctxvar(cv.origin()));
+
+	delta->subregion()->copy(constant->subregion(), smap, false, false);
+	auto output = constant->finalize(smap.lookup(delta->result()->origin()));
+
+	delta->output()->divert_users(output);
+	remove(delta);
+}
+
+static size_t
+mark_constant(jive::region * region)
+{
+	size_t nconstant = 0;
+	std::vector<delta::node*> deltas;
+	for (auto & node : region->nodes) {
+		if (auto delta = dynamic_cast<delta::node*>(&node)) {
+			if (!delta->constant() && is_readonly(delta))
+				deltas.push_back(delta);
+		}
+
+		if (is<jive::phi::operation>(&node))
+			nconstant += mark_constant(static_cast<jive::structural_node*>(&node)->subregion(0));
+	}
+
+	for (const auto & delta : deltas)
+		make_constant(delta);
+
+	return nconstant + deltas.size();
+}
+
+/* load folding */
+
+/*
+	Traces \p output through context variables, gamma entry variables, and invariant loop
+	variables to its originating delta.
+*/
+static const delta::node *
+trace_delta(const jive::output * output)
+{
+	while (true) {
+		if (auto o = dynamic_cast<const delta::output*>(output))
+			return o->node();
+
+		auto argument = dynamic_cast<const jive::argument*>(output);
+		if (!argument || !argument->input())
+			return nullptr;
+
+		auto node = argument->region()->node();
+		if (is<jive::theta_op>(node)
+		&& !is_invariant(static_cast<const jive::theta_input*>(argument->input())))
+			return nullptr;
+
+		if (!is<lambda::operation>(node) && !is<jive::gamma_op>(node) && !is<jive::theta_op>(node)
+		&& !is_phi_cv(argument))
+			return nullptr;
+
+		output = argument->input()->origin();
+	}
+}
+
+static bool
+constant_index(const jive::output * output, size_t & index)
+{
+	auto node = jive::node_output::node(output);
+	if (!is<jive::bitconstant_op>(node))
+		return false;
+
+	auto & value = static_cast<const jive::bitconstant_op*>(&node->operation())->value();
+	if (!value.is_known())
+		return false;
+
+	index = value.to_uint();
+	return true;
+}
+
+/*
+	Returns the element \p index of the constant aggregate \p value, or nullptr if \p value is
+	not a constant aggregate.
+*/
+static jive::output *
+element(jive::output * value, size_t index)
+{
+	auto node = jive::node_output::node(value);
+	if (!is<ConstantDataArray>(node) && !is<ConstantArray>(node) && !is<struct_constant_op>(node))
+		return nullptr;
+
+	return index < node->ninputs() ? node->input(index)->origin() : nullptr;
+}
+
+/*
+	Returns the value a load from \p address produces, or nullptr if it cannot be determined.
+*/
+static jive::output *
+loaded_value(const jive::output * address)
+{
+	std::vector<size_t> indices;
+	auto node = jive::node_output::node(address);
+	if (is<getelementptr_op>(node)) {
+		for (size_t n = 1; n < node->ninputs(); n++) {
+			size_t index;
+			if (!constant_index(node->input(n)->origin(), index))
+				return nullptr;
+			indices.push_back(index);
+		}
+
+		if (indices.empty() || indices[0] != 0)
+			return nullptr;
+
+		address = node->input(0)->origin();
+	}
+
+	auto delta = trace_delta(address);
+	if (!delta || !delta->constant())
+		return nullptr;
+
+	auto value = delta->result()->origin();
+	for (size_t n = 1; n < indices.size() && value; n++)
+		value = element(value, indices[n]);
+
+	return value;
+}
+
+static bool
+fold(jive::node * load)
+{
+	auto value = loaded_value(load->input(0)->origin());
+	if (!value || value->type() != load->output(0)->type())
+		return false;
+
+	auto node = jive::node_output::node(value);
+	if (!dynamic_cast<const jive::simple_node*>(node) || node->ninputs() != 0)
+		return false;
+
+	auto copy = node->copy(load->region(), {});
+	load->output(0)->divert_users(copy->output(0));
+	for (size_t n = 1; n < load->noutputs(); n++)
+		load->output(n)->divert_users(load->input(n)->origin());
+
+	remove(load);
+	return true;
+}
+
+static void
+collect_loads(jive::region * region, std::vector<jive::node*> & loads)
+{
+	for (auto & node : region->nodes) {
+		if (is<load_op>(&node))
+			loads.push_back(&node);
+
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_loads(structnode->subregion(n), loads);
+		}
+	}
+}
+
+static size_t
+fold_loads(jive::graph & graph)
+{
+	std::vector<jive::node*> loads;
+	collect_loads(graph.root(), loads);
+
+	size_t nfolded = 0;
+	for (const auto & load : loads)
+		nfolded += fold(load);
+
+	return nfolded;
+}
+
+static void
+fold(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	glfstat stat;
+	stat.start(graph);
+	auto nconstant = mark_constant(graph.root());
+	auto nfolded = fold_loads(graph);
+	stat.end(graph, nconstant, nfolded);
+
+	if (sd.print_globalfolding_stat)
+		sd.print_stat(stat);
+}
+
+/* globalfolding class */
+
+globalfolding::~globalfolding()
+{}
+
+void
+globalfolding::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	fold(module, sd);
+}
+
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/heap2stack.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+namespace jlm {
+
+class h2sstat final : public stat {
+public:
+	virtual
+	~h2sstat()
+	{}
+
+	h2sstat()
+	: nmallocs_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nmallocs) noexcept
+	{
+		nmallocs_ = nmallocs;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("H2S ", nnodes_before_, " ", nnodes_after_, " ", nmallocs_, " ", timer_.ns());
+	}
+
+private:
+	size_t nmallocs_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/*
+	Malloc guarantees an alignment that is suitable for any type.
+*/
+static const size_t malloc_alignment = 16;
+
+/*
+	Checks whether \p pointer escapes. Pointers passed into gammas and thetas are followed into
+	their subregions, and pointers derived by getelementptrs and bitcasts are followed as well.
+	The frees of the pointer are added to \p frees.
+*/
+static bool
+escapes(jive::output * pointer, std::vector<jive::node*> & frees)
+{
+	for (const auto & user : *pointer) {
+		if (auto input = dynamic_cast<jive::gamma_input*>(user)) {
+			for (size_t n = 0; n < input->narguments(); n++) {
+				if (escapes(input->argument(n), frees))
+					return true;
+			}
+			continue;
+		}
+
+		if (auto input = dynamic_cast<jive::theta_input*>(user)) {
+			if (!is_invariant(input)
+			|| escapes(input->argument(), frees)
+			|| escapes(input->output(), frees))
+				return true;
+			continue;
+		}
+
+		auto argument = dynamic_cast<jive::argument*>(pointer);
+		if (argument && is<jive::theta_op>(argument->region()->node())
+		&& user == static_cast<jive::theta_input*>(argument->input())->result())
+			continue;
+
+		auto node = input_node(user);
+		if (!dynamic_cast<const jive::simple_node*>(node))
+			return true;
+
+		if (is<getelementptr_op>(node) && user->index() == 0) {
+			if (escapes(node->output(0), frees))
+				return true;
+			continue;
+		}
+
+		if (is<bitcast_op>(node)) {
+			if (escapes(node->output(0), frees))
+				return true;
+			continue;
+		}
+
+		if (is<free_op>(node)) {
+			frees.push_back(node);
+			continue;
+		}
+
+		if ((is<load_op>(node) || is<store_op>(node)) && user->index() == 0)
+			continue;
+
+		if (is<Memcpy>(node) && user->index() < 2)
+			continue;
+
+		return true;
+	}
+
+	return false;
+}
+
+static bool
+is_promotable(const jive::node * mnode, size_t limit, jive::node *& fnode)
+{
+	if (!is<lambda::operation>(mnode->region()->node()))
+		return false;
+
+	auto node = jive::node_output::node(mnode->input(0)->origin());
+	if (!is<jive::bitconstant_op>(node))
+		return false;
+
+	auto & value = static_cast<const jive::bitconstant_op*>(&node->operation())->value();
+	if (!value.is_known() || value.to_uint() == 0 || value.to_uint() > limit)
+		return false;
+
+	std::vector<jive::node*> frees;
+	if (escapes(mnode->output(0), frees))
+		return false;
+
+	/*
+		A single free in the region of the malloc is executed on all paths.
+	*/
+	if (frees.size() != 1 || frees[0]->region() != mnode->region())
+		return false;
+
+	fnode = frees[0];
+	return true;
+}
+
+static void
+promote(jive::node * mnode, jive::node * fnode)
+{
+	auto size = mnode->input(0)->origin();
+	auto alloca = alloca_op::create(jive::bit8, size, malloc_alignment);
+	mnode->output(0)->divert_users(alloca[0]);
+	mnode->output(1)->divert_users(alloca[1]);
+
+	/*
+		The free passes its memory states and io state through.
+	*/
+	for (size_t n = 0; n < fnode->noutputs(); n++)
+		fnode->output(n)->divert_users(fnode->input(n+1)->origin());
+
+	remove(fnode);
+	remove(mnode);
+}
+
+static void
+collect_mallocs(jive::region * region, std::vector<jive::node*> & mallocs)
+{
+	for (auto & node : region->nodes) {
+		if (is<malloc_op>(&node))
+			mallocs.push_back(&node);
+
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_mallocs(structnode->subregion(n), mallocs);
+		}
+	}
+}
+
+static void
+heap2stack(rvsdg_module & rm, const stats_descriptor & sd, size_t limit)
+{
+	auto & graph = *rm.graph();
+
+	h2sstat stat;
+	stat.start(graph);
+
+	std::vector<jive::node*> mallocs;
+	collect_mallocs(graph.root(), mallocs);
+
+	size_t nmallocs = 0;
+	for (const auto & mnode : mallocs) {
+		jive::node * fnode = nullptr;
+		if (is_promotable(mnode, limit, fnode)) {
+			promote(mnode, fnode);
+			nmallocs++;
+		}
+	}
+
+	stat.end(graph, nmallocs);
+
+	if (sd.print_heap2stack_stat)
+		sd.print_stat(stat);
+}
+
+/* heap2stack class */
+
+heap2stack::~heap2stack()
+{}
+
+void
+heap2stack::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	jlm::heap2stack(module, sd, limit_);
+}
+
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/ifconversion.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/types/bitstring/arithmetic.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/substitution.hpp>
+
+namespace jlm {
+
+class ifcstat final : public stat {
+public:
+	virtual
+	~ifcstat()
+	{}
+
+	ifcstat()
+	: ngammas_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t ngammas) noexcept
+	{
+		ngammas_ = ngammas;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("IFC ", nnodes_before_, " ", nnodes_after_, " ", ngammas_, " ", timer_.ns());
+	}
+
+private:
+	size_t ngammas_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/*
+	A node can be speculatively executed if it neither has side effects nor can trap. Nodes with
+	side effects are recognized by their state operands and results.
+*/
+static bool
+is_speculatable(const jive::node & node)
+{
+	if (!dynamic_cast<const jive::simple_node*>(&node))
+		return false;
+
+	/* vector operations trap if their element-wise operation traps */
+	auto op = &node.operation();
+	if (auto vop = dynamic_cast<const vectorbinary_op*>(op))
+		op = &vop->operation();
+
+	if (is<jive::bitsdiv_op>(*op) || is<jive::bitudiv_op>(*op)
+	|| is<jive::bitsmod_op>(*op) || is<jive::bitumod_op>(*op))
+		return false;
+
+	for (size_t n = 0; n < node.ninputs(); n++) {
+		if (dynamic_cast<const jive::statetype*>(&node.input(n)->type()))
+			return false;
+	}
+
+	for (size_t n = 0; n < node.noutputs(); n++) {
+		if (dynamic_cast<const jive::statetype*>(&node.output(n)->type()))
+			return false;
+	}
+
+	return true;
+}
+
+static bool
+is_convertible(const jive::gamma_node & gamma, size_t threshold)
+{
+	if (gamma.nsubregions() != 2)
+		return false;
+
+	size_t nnodes = 0;
+	for (size_t n = 0; n < gamma.nsubregions(); n++) {
+		for (const auto & node : gamma.subregion(n)->nodes) {
+			if (!is_speculatable(node))
+				return false;
+			nnodes++;
+		}
+	}
+	if (nnodes > threshold)
+		return false;
+
+	/*
+		State outputs cannot be selected. They are only permitted if they are passed through
+		unchanged.
+	*/
+	for (size_t n = 0; n < gamma.noutputs(); n++) {
+		auto output = static_cast<const jive::gamma_output*>(gamma.output(n));
+		if (dynamic_cast<const jive::statetype*>(&output->type()) && !is_invariant(output))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	Converts the control predicate of a two-way gamma to a bit predicate. A one bit match is
+	reduced to its operand, which requires the operands of the select to be swapped if the match
+	inverts its operand.
+*/
+static std::pair<jive::output*, bool>
+convert_predicate(jive::output * predicate)
+{
+	auto node = jive::node_output::node(predicate);
+	if (is<jive::match_op>(node)) {
+		auto match = static_cast<const jive::match_op*>(&node->operation());
+		if (match->nbits() == 1 && match->alternative(0) != match->alternative(1))
+			return {node->input(0)->origin(), match->alternative(1) == 0};
+	}
+
+	auto & type = *static_cast<const jive::ctltype*>(&predicate->type());
+	ctl2bits_op op(type, jive::bit1);
+	return {jive::simple_node::create_normalized(predicate->region(), op, {predicate})[0], false};
+}
+
+static void
+convert(jive::gamma_node * gamma)
+{
+	auto region = gamma->region();
+
+	std::vector<jive::substitution_map> smap(gamma->nsubregions());
+	for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++) {
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			smap[n].insert(ev->argument(n), ev->origin());
+	}
+
+	for (size_t n = 0; n < gamma->nsubregions(); n++)
+		gamma->subregion(n)->copy(region, smap[n], false, false);
+
+	std::pair<jive::output*, bool> predicate(nullptr, false);
+	for (size_t n = 0; n < gamma->noutputs(); n++) {
+		auto output = gamma->output(n);
+		auto o0 = smap[0].lookup(gamma->subregion(0)->result(n)->origin());
+		auto o1 = smap[1].lookup(gamma->subregion(1)->result(n)->origin());
+
+		if (o0 == o1) {
+			output->divert_users(o0);
+			continue;
+		}
+
+		if (predicate.first == nullptr)
+			predicate = convert_predicate(gamma->predicate()->origin());
+
+		auto t = predicate.second ? o0 : o1;
+		auto f = predicate.second ? o1 : o0;
+		select_op op(output->type());
+		auto select = jive::simple_node::create_normalized(region, op, {predicate.first, t, f})[0];
+		output->divert_users(select);
+	}
+
+	remove(gamma);
+}
+
+static size_t
+convert(jive::region * region, size_t threshold)
+{
+	size_t ngammas = 0;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				ngammas += convert(structnode->subregion(n), threshold);
+		}
+	}
+
+	/*
+		Collect the gammas first, since the conversion removes them from the region.
+	*/
+	std::vector<jive::gamma_node*> gammas;
+	for (auto & node : region->nodes) {
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(&node)) {
+			if (is_convertible(*gamma, threshold))
+				gammas.push_back(gamma);
+		}
+	}
+
+	for (const auto & gamma : gammas)
+		convert(gamma);
+
+	return ngammas + gammas.size();
+}
+
+static void
+ifconversion(rvsdg_module & rm, const stats_descriptor & sd, size_t threshold)
+{
+	auto & graph = *rm.graph();
+
+	ifcstat stat;
+	stat.start(graph);
+	auto ngammas = convert(graph.root(), threshold);
+	stat.end(graph, ngammas);
+
+	if (sd.print_ifconversion_stat)
+		sd.print_stat(stat);
+}
+
+/* ifconversion class */
+
+ifconversion::~ifconversion()
+{}
+
+void
+ifconversion::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	jlm::ifconversion(module, sd, threshold_);
+}
+
+}
@@ -11,6 +11,7 @@
 #include <jlm/util/time.hpp>
 
 #include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/phi.hpp>
 #include <jive/rvsdg/substitution.hpp>
 #include <jive/rvsdg/theta.hpp>
 #include <jive/rvsdg/traverser.hpp>
@@ -30,14 +31,14 @@ public:
 	void
 	start(const jive::graph & graph)
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		timer_.start();
 	}
 
 	void
 	stop(const jive::graph & graph)
 	{
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 		timer_.stop();
 	}
 
@@ -113,7 +114,7 @@ find_producer(jive::input * input)
 	return find_producer(argument->input());
 }
 
-static jive::output *
+jive::output *
 route_to_region(jive::output * output, jive::region * region)
 {
 	JLM_ASSERT(region != nullptr);
@@ -130,6 +131,8 @@ route_to_region(jive::output * output, jive::region * region)
 		output = theta->add_loopvar(output)->argument();
 	} else if (auto lambda = dynamic_cast<lambda::node*>(region->node())) {
 		output = lambda->add_ctxvar(output);
+	} else if (auto phi = dynamic_cast<jive::phi::node*>(region->node())) {
+		output = phi->add_ctxvar(output);
 	} else {
 		JLM_ASSERT(0);
 	}
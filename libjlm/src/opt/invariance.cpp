@@ -32,7 +32,7 @@ public:
 	void
 	start(const jive::graph & graph) noexcept
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		ninputs_before_ = jive::ninputs(graph.root());
 		timer_.start();
 	}
@@ -40,7 +40,7 @@ public:
 	void
 	end(const jive::graph & graph) noexcept
 	{
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 		ninputs_after_ = jive::ninputs(graph.root());
 		timer_.stop();
 	}
@@ -121,12 +121,13 @@ invariance(rvsdg_module & rm, const stats_descriptor & sd)
 {
 	invstat stat;
 
-	stat.start(*rm.graph());
-	invariance(rm.graph()->root());
-	stat.end(*rm.graph());
-
 	if (sd.print_inv_stat)
+		stat.start(*rm.graph());
+	invariance(rm.graph()->root());
+	if (sd.print_inv_stat) {
+		stat.end(*rm.graph());
 		sd.print_stat(stat);
+	}
 }
 
 /* ivr class */
@@ -33,7 +33,7 @@ public:
 	void
 	start(const jive::graph & graph) noexcept
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		ninputs_before_ = jive::ninputs(graph.root());
 		timer_.start();
 	}
@@ -41,7 +41,7 @@ public:
 	void
 	end(const jive::graph & graph) noexcept
 	{
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 		ninputs_after_ = jive::ninputs(graph.root());
 		timer_.stop();
 	}
@@ -298,12 +298,13 @@ invert(rvsdg_module & rm, const stats_descriptor & sd)
 {
 	ivtstat stat;
 
-	stat.start(*rm.graph());
-	invert(rm.graph()->root());
-	stat.end(*rm.graph());
-
 	if (sd.print_ivt_stat)
+		stat.start(*rm.graph());
+	invert(rm.graph()->root());
+	if (sd.print_ivt_stat) {
+		stat.end(*rm.graph());
 		sd.print_stat(stat);
+	}
 }
 
 /* tginversion */
@@ -0,0 +1,418 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/memcpyexpansion.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace jlm {
+
+class mcpstat final : public stat {
+public:
+	virtual
+	~mcpstat()
+	{}
+
+	mcpstat()
+	: nexpanded_(0)
+	, nforwarded_(0)
+	, nremoved_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(
+		const jive::graph & graph,
+		size_t nexpanded,
+		size_t nforwarded,
+		size_t nremoved) noexcept
+	{
+		nexpanded_ = nexpanded;
+		nforwarded_ = nforwarded;
+		nremoved_ = nremoved;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("MCP ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			nexpanded_, " ", nforwarded_, " ", nremoved_, " ",
+			timer_.ns()
+		);
+	}
+
+private:
+	size_t nexpanded_;
+	size_t nforwarded_;
+	size_t nremoved_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+static const jive::bitvalue_repr *
+constant_value(const jive::output * output)
+{
+	auto node = jive::node_output::node(output);
+	if (!is<jive::bitconstant_op>(node))
+		return nullptr;
+
+	auto & value = static_cast<const jive::bitconstant_op*>(&node->operation())->value();
+	return value.is_known() ? &value : nullptr;
+}
+
+static bool
+is_nonvolatile(const jive::node * copy)
+{
+	auto v = constant_value(copy->input(3)->origin());
+	return v && v->to_uint() == 0;
+}
+
+/* expansion */
+
+/*
+	A chunk of \p nbytes bytes at byte \p offset of the address \p base.
+*/
+struct chunk {
+	jive::output * base;
+	size_t offset;
+	size_t nbytes;
+};
+
+/*
+	Expands memcpys into sequences of loads and stores. The address of every chunk is only
+	computed once, such that the loads and stores of the same chunk share their address, and
+	the values that are copied through temporaries can be forwarded afterwards.
+*/
+class expander final {
+public:
+	void
+	expand(jive::node * copy, size_t length)
+	{
+		auto destination = copy->input(0)->origin();
+		auto source = copy->input(1)->origin();
+
+		std::vector<jive::output*> states;
+		for (size_t n = 4; n < copy->ninputs(); n++)
+			states.push_back(copy->input(n)->origin());
+
+		/*
+			All chunks are loaded before any of them is stored, such that the loads of a chunk only
+			have other loads between them and the stores of a preceding expansion.
+		*/
+		std::vector<std::pair<chunk, jive::output*>> values;
+		size_t offset = 0;
+		while (offset < length) {
+			size_t nbytes = 8;
+			while (nbytes > length - offset)
+				nbytes /= 2;
+
+			auto load = load_op::create(address({source, offset, nbytes}), states, 1);
+			loads_.push_back(jive::node_output::node(load[0]));
+			states = std::vector<jive::output*>(std::next(load.begin()), load.end());
+			values.push_back({{destination, offset, nbytes}, load[0]});
+
+			offset += nbytes;
+		}
+
+		for (const auto & value : values)
+			states = store_op::create(address(value.first), value.second, states, 1);
+
+		for (size_t n = 0; n < copy->noutputs(); n++)
+			copy->output(n)->divert_users(states[n]);
+
+		remove(copy);
+	}
+
+	/*
+		Forwards the value of the closest preceding store to the same chunk to every load of the
+		expansions. Stores to disjoint chunks of the same address are skipped, while any other
+		write ends the search. Returns the number of forwarded loads.
+	*/
+	size_t
+	forward()
+	{
+		size_t nforwarded = 0;
+		for (const auto & load : loads_) {
+			auto store = find_store(load);
+			if (store == nullptr)
+				continue;
+
+			load->output(0)->divert_users(store->input(1)->origin());
+			for (size_t n = 1; n < load->noutputs(); n++)
+				load->output(n)->divert_users(load->input(n)->origin());
+			remove(load);
+			nforwarded++;
+		}
+
+		return nforwarded;
+	}
+
+private:
+	/*
+		Computes the address of \p c, or returns the previously computed one.
+	*/
+	jive::output *
+	address(const chunk & c)
+	{
+		auto key = std::make_tuple(c.base, c.offset, c.nbytes);
+		auto it = addresses_.find(key);
+		if (it != addresses_.end())
+			return it->second;
+
+		auto address = c.base;
+		if (c.offset != 0) {
+			auto index = jive::create_bitconstant(address->region(), 64, c.offset);
+			address = getelementptr_op::create(address, {index}, ptrtype(jive::bit8));
+		}
+
+		jive::bittype type(c.nbytes*8);
+		if (type != jive::bit8)
+			address = bitcast_op::create(address, ptrtype(type));
+
+		addresses_[key] = address;
+		chunks_[address] = c;
+		return address;
+	}
+
+	/*
+		Returns the node that produces all memory states consumed by \p node in order, or
+		nullptr if there is no such node.
+	*/
+	static jive::node *
+	state_producer(const jive::node * node)
+	{
+		auto nstates = node->noutputs() - is<load_op>(node);
+		auto first = node->ninputs() - nstates;
+		auto producer = jive::node_output::node(node->input(first)->origin());
+		if (!is<load_op>(producer) && !is<store_op>(producer))
+			return nullptr;
+
+		if (producer->noutputs() - is<load_op>(producer) != nstates)
+			return nullptr;
+
+		for (size_t n = 0; n < nstates; n++) {
+			auto state = producer->output(producer->noutputs() - nstates + n);
+			if (node->input(first+n)->origin() != state)
+				return nullptr;
+		}
+
+		return producer;
+	}
+
+	jive::node *
+	find_store(const jive::node * load)
+	{
+		auto & c = chunks_[load->input(0)->origin()];
+
+		auto node = state_producer(load);
+		while (node != nullptr) {
+			if (is<store_op>(node)) {
+				auto it = chunks_.find(node->input(0)->origin());
+				if (it == chunks_.end() || it->second.base != c.base)
+					return nullptr;
+
+				auto & sc = it->second;
+				if (sc.offset == c.offset && sc.nbytes == c.nbytes)
+					return node;
+
+				if (sc.offset < c.offset + c.nbytes && c.offset < sc.offset + sc.nbytes)
+					return nullptr;
+			}
+
+			node = state_producer(node);
+		}
+
+		return nullptr;
+	}
+
+	std::vector<jive::node*> loads_;
+	std::unordered_map<const jive::output*, chunk> chunks_;
+	std::map<std::tuple<jive::output*, size_t, size_t>, jive::output*> addresses_;
+};
+
+static void
+collect_memcpys(jive::region * region, std::vector<jive::node*> & memcpys)
+{
+	for (auto & node : region->nodes) {
+		if (is<Memcpy>(&node))
+			memcpys.push_back(&node);
+
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_memcpys(structnode->subregion(n), memcpys);
+		}
+	}
+}
+
+static size_t
+expand(jive::graph & graph, size_t limit, size_t & nforwarded)
+{
+	std::vector<jive::node*> memcpys;
+	collect_memcpys(graph.root(), memcpys);
+
+	expander e;
+	size_t nexpanded = 0;
+	for (const auto & copy : memcpys) {
+		auto length = constant_value(copy->input(2)->origin());
+		if (!length || length->to_uint() == 0 || length->to_uint() > limit || !is_nonvolatile(copy))
+			continue;
+
+		e.expand(copy, length->to_uint());
+		nexpanded++;
+	}
+
+	nforwarded = e.forward();
+	return nexpanded;
+}
+
+/* dead store elimination */
+
+/*
+	Collects the stores and memcpys that write to \p address. Returns false if the memory at
+	\p address might be read, i.e., \p address is used by anything else than the address of a
+	store or the destination of a non-volatile memcpy, getelementptrs, bitcasts, gammas, and
+	invariant loop variables.
+*/
+static bool
+collect_writes(jive::output * address, std::vector<jive::node*> & writes)
+{
+	for (const auto & user : *address) {
+		if (auto input = dynamic_cast<jive::gamma_input*>(user)) {
+			for (size_t n = 0; n < input->narguments(); n++) {
+				if (!collect_writes(input->argument(n), writes))
+					return false;
+			}
+			continue;
+		}
+
+		if (auto input = dynamic_cast<jive::theta_input*>(user)) {
+			if (!is_invariant(input)
+			|| !collect_writes(input->argument(), writes)
+			|| !collect_writes(input->output(), writes))
+				return false;
+			continue;
+		}
+
+		auto argument = dynamic_cast<jive::argument*>(address);
+		if (argument && is<jive::theta_op>(argument->region()->node())
+		&& user == static_cast<jive::theta_input*>(argument->input())->result())
+			continue;
+
+		auto node = input_node(user);
+		if (!dynamic_cast<const jive::simple_node*>(node))
+			return false;
+
+		if ((is<getelementptr_op>(node) && user->index() == 0) || is<bitcast_op>(node)) {
+			if (!collect_writes(node->output(0), writes))
+				return false;
+			continue;
+		}
+
+		if ((is<store_op>(node) && user->index() == 0)
+		|| (is<Memcpy>(node) && user->index() == 0 && is_nonvolatile(node))) {
+			writes.push_back(node);
+			continue;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+static void
+remove_write(jive::node * node)
+{
+	size_t nstates = node->noutputs();
+	for (size_t n = 0; n < nstates; n++)
+		node->output(n)->divert_users(node->input(node->ninputs()-nstates+n)->origin());
+
+	remove(node);
+}
+
+static void
+collect_allocas(jive::region * region, std::vector<jive::node*> & allocas)
+{
+	for (auto & node : region->nodes) {
+		if (is<alloca_op>(&node))
+			allocas.push_back(&node);
+
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_allocas(structnode->subregion(n), allocas);
+		}
+	}
+}
+
+static size_t
+remove_dead_writes(jive::graph & graph)
+{
+	std::vector<jive::node*> allocas;
+	collect_allocas(graph.root(), allocas);
+
+	size_t nremoved = 0;
+	for (const auto & alloca : allocas) {
+		std::vector<jive::node*> writes;
+		if (!collect_writes(alloca->output(0), writes))
+			continue;
+
+		for (const auto & write : writes)
+			remove_write(write);
+		nremoved += writes.size();
+	}
+
+	return nremoved;
+}
+
+static void
+expand(rvsdg_module & rm, const stats_descriptor & sd, size_t limit)
+{
+	auto & graph = *rm.graph();
+
+	mcpstat stat;
+	stat.start(graph);
+	size_t nforwarded = 0;
+	auto nexpanded = expand(graph, limit, nforwarded);
+	auto nremoved = remove_dead_writes(graph);
+	stat.end(graph, nexpanded, nforwarded, nremoved);
+
+	if (sd.print_memcpyexpansion_stat)
+		sd.print_stat(stat);
+}
+
+/* memcpyexpansion class */
+
+memcpyexpansion::~memcpyexpansion()
+{}
+
+void
+memcpyexpansion::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	expand(module, sd, limit_);
+}
+
+}
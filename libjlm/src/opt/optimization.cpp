@@ -46,7 +46,7 @@ public:
 	void
 	start(const jive::graph & graph) noexcept
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		timer_.start();
 	}
 
@@ -54,7 +54,7 @@ public:
 	end(const jive::graph & graph) noexcept
 	{
 		timer_.stop();
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 	}
 
 	virtual std::string
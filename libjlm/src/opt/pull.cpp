@@ -280,12 +280,13 @@ pull(rvsdg_module & rm, const stats_descriptor & sd)
 {
 	pullstat stat;
 
-	stat.start(*rm.graph());
-	pull(rm.graph()->root());
-	stat.end(*rm.graph());
-
 	if (sd.print_pull_stat)
+		stat.start(*rm.graph());
+	pull(rm.graph()->root());
+	if (sd.print_pull_stat) {
+		stat.end(*rm.graph());
 		sd.print_stat(stat);
+	}
 }
 
 /* pullin class */
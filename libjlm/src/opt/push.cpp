@@ -405,12 +405,13 @@ push(rvsdg_module & rm, const stats_descriptor & sd)
 {
 	pushstat stat;
 
-	stat.start(*rm.graph());
-	push(rm.graph()->root());
-	stat.end(*rm.graph());
-
 	if (sd.print_push_stat)
+		stat.start(*rm.graph());
+	push(rm.graph()->root());
+	if (sd.print_push_stat) {
+		stat.end(*rm.graph());
 		sd.print_stat(stat);
+	}
 }
 
 /* pushout class */
@@ -6,6 +6,7 @@
 #include <jive/rvsdg/binary.hpp>
 #include <jive/rvsdg/gamma.hpp>
 #include <jive/rvsdg/statemux.hpp>
+#include <jive/rvsdg/structural-node.hpp>
 
 #include <jlm/ir/operators.hpp>
 #include <jlm/ir/rvsdg-module.hpp>
@@ -29,7 +30,7 @@ public:
 	void
 	start(const jive::graph & graph) noexcept
 	{
-		nnodes_before_ = jive::nnodes(graph.root());
+		nnodes_before_ = jlm::nnodes(graph);
 		ninputs_before_ = jive::ninputs(graph.root());
 		timer_.start();
 	}
@@ -37,7 +38,7 @@ public:
 	void
 	end(const jive::graph & graph) noexcept
 	{
-		nnodes_after_ = jive::nnodes(graph.root());
+		nnodes_after_ = jlm::nnodes(graph);
 		ninputs_after_ = jive::ninputs(graph.root());
 		timer_.stop();
 	}
@@ -58,6 +59,35 @@ private:
 	jlm::timer timer_;
 };
 
+/*
+	Touches all nodes of \p region and its subregions in the order of the region's node lists.
+*/
+static void
+touch_all(rvsdg_module & rm, jive::region * region)
+{
+	for (auto & node : region->nodes) {
+		rm.touch(&node);
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				touch_all(rm, structnode->subregion(n));
+		}
+	}
+}
+
+/*
+	Normalizes the touched nodes of \p rm in the order they were touched until none are left.
+	Rewriting a node diverts its users, which touches them in turn.
+*/
+static void
+reduce_touched(rvsdg_module & rm)
+{
+	auto & graph = *rm.graph();
+	while (auto node = rm.pop_touched_node()) {
+		auto nf = graph.node_normal_form(typeid(node->operation()));
+		nf->normalize_node(node);
+	}
+}
+
 static void
 enable_mux_reductions(jive::graph & graph)
 {
@@ -119,12 +149,13 @@ enable_binary_reductions(jive::graph & graph)
 }
 
 static void
-reduce(rvsdg_module & rm, const stats_descriptor & sd)
+reduce(rvsdg_module & rm, bool sweep, const stats_descriptor & sd)
 {
 	auto & graph = *rm.graph();
 
 	redstat stat;
-	stat.start(graph);
+	if (sd.print_reduction_stat)
+		stat.start(graph);
 
 	enable_mux_reductions(graph);
 	enable_store_reductions(graph);
@@ -133,11 +164,22 @@ reduce(rvsdg_module & rm, const stats_descriptor & sd)
 	enable_unary_reductions(graph);
 	enable_binary_reductions(graph);
 
-	graph.normalize();
-	stat.end(graph);
+	if (sweep) {
+		graph.normalize();
+		rm.clear_touched_nodes();
+		rm.record_touched_nodes();
+	} else {
+		if (!rm.records_touched_nodes()) {
+			rm.record_touched_nodes();
+			touch_all(rm, graph.root());
+		}
+		reduce_touched(rm);
+	}
 
-	if (sd.print_reduction_stat)
+	if (sd.print_reduction_stat) {
+		stat.end(graph);
 		sd.print_stat(stat);
+	}
 }
 
 /* nodereduction class */
@@ -148,7 +190,7 @@ nodereduction::~nodereduction()
 void
 nodereduction::run(rvsdg_module & module, const stats_descriptor & sd)
 {
-	reduce(module, sd);
+	reduce(module, sweep_, sd);
 }
 
 }
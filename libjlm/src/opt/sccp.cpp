@@ -0,0 +1,808 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/sccp.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/types/bitstring/arithmetic.hpp>
+#include <jive/types/bitstring/comparison.hpp>
+#include <jive/types/bitstring/constant.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/phi.hpp>
+#include <jive/rvsdg/substitution.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/rvsdg/traverser.hpp>
+
+#include <algorithm>
+#include <deque>
+
+namespace jlm {
+
+class sccpstat final : public stat {
+public:
+	virtual
+	~sccpstat()
+	{}
+
+	sccpstat()
+	: nnodes_before_(0), nnodes_after_(0)
+	, ninputs_before_(0), ninputs_after_(0)
+	{}
+
+	void
+	start_analysis_stat(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		ninputs_before_ = jive::ninputs(graph.root());
+		analysis_timer_.start();
+	}
+
+	void
+	end_analysis_stat() noexcept
+	{
+		analysis_timer_.stop();
+	}
+
+	void
+	start_transformation_stat() noexcept
+	{
+		transformation_timer_.start();
+	}
+
+	void
+	end_transformation_stat(const jive::graph & graph) noexcept
+	{
+		nnodes_after_ = jlm::nnodes(graph);
+		ninputs_after_ = jive::ninputs(graph.root());
+		transformation_timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("SCCP ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			ninputs_before_, " ", ninputs_after_, " ",
+			analysis_timer_.ns(), " ", transformation_timer_.ns()
+		);
+	}
+
+private:
+	size_t nnodes_before_, nnodes_after_;
+	size_t ninputs_before_, ninputs_after_;
+	jlm::timer analysis_timer_, transformation_timer_;
+};
+
+/* lattice value */
+
+/*
+	A value of the constant propagation lattice. A value is either undefined (top), a known
+	constant, or overdefined (bottom). Constants are represented by the nullary operation that
+	produces them, i.e., a bitconstant_op or a ctlconstant_op.
+*/
+class cnstvalue final {
+	enum class kind {top, constant, bottom};
+
+	cnstvalue(
+		enum kind kind,
+		std::unique_ptr<jive::operation> op)
+	: kind_(kind)
+	, op_(std::move(op))
+	{}
+
+public:
+	cnstvalue(const cnstvalue & other)
+	: kind_(other.kind_)
+	, op_(other.op_ ? other.op_->copy() : nullptr)
+	{}
+
+	cnstvalue(cnstvalue && other) = default;
+
+	cnstvalue &
+	operator=(const cnstvalue & other)
+	{
+		if (this == &other)
+			return *this;
+
+		kind_ = other.kind_;
+		op_ = other.op_ ? other.op_->copy() : nullptr;
+
+		return *this;
+	}
+
+	cnstvalue &
+	operator=(cnstvalue && other) = default;
+
+	bool
+	is_top() const noexcept
+	{
+		return kind_ == kind::top;
+	}
+
+	bool
+	is_constant() const noexcept
+	{
+		return kind_ == kind::constant;
+	}
+
+	bool
+	is_bottom() const noexcept
+	{
+		return kind_ == kind::bottom;
+	}
+
+	const jive::simple_op &
+	operation() const noexcept
+	{
+		JLM_ASSERT(is_constant());
+		return *static_cast<const jive::simple_op*>(op_.get());
+	}
+
+	bool
+	operator==(const cnstvalue & other) const noexcept
+	{
+		if (kind_ != other.kind_)
+			return false;
+
+		return !is_constant() || operation() == other.operation();
+	}
+
+	bool
+	operator!=(const cnstvalue & other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+	cnstvalue
+	meet(const cnstvalue & other) const
+	{
+		if (is_top())
+			return other;
+
+		if (other.is_top())
+			return *this;
+
+		if (is_constant() && other.is_constant() && operation() == other.operation())
+			return *this;
+
+		return bottom();
+	}
+
+	static cnstvalue
+	top()
+	{
+		return cnstvalue(kind::top, nullptr);
+	}
+
+	static cnstvalue
+	bottom()
+	{
+		return cnstvalue(kind::bottom, nullptr);
+	}
+
+	static cnstvalue
+	constant(const jive::simple_op & op)
+	{
+		return cnstvalue(kind::constant, op.copy());
+	}
+
+private:
+	enum kind kind_;
+	std::unique_ptr<jive::operation> op_;
+};
+
+/* sccp context */
+
+class sccpctx final {
+public:
+	sccpctx()
+	: top_(cnstvalue::top())
+	, bottom_(cnstvalue::bottom())
+	{}
+
+	const cnstvalue &
+	value(const jive::output * output) const noexcept
+	{
+		if (!is_tracked(output->type()))
+			return bottom_;
+
+		auto it = values_.find(output);
+		return it != values_.end() ? it->second : top_;
+	}
+
+	/*
+		Lowers the lattice value of \p output to the meet of its current value and \p value. If the
+		value of \p output changed, then all its users are queued for reevaluation.
+	*/
+	void
+	lower(jive::output * output, const cnstvalue & value)
+	{
+		if (!is_tracked(output->type()))
+			return;
+
+		auto it = values_.find(output);
+		if (it == values_.end()) {
+			if (value.is_top())
+				return;
+
+			values_.insert({output, value});
+		} else {
+			auto v = it->second.meet(value);
+			if (v == it->second)
+				return;
+
+			it->second = std::move(v);
+		}
+
+		push_users(output);
+	}
+
+	/*
+		A lambda is internal if all its uses are direct calls. Only the function arguments of
+		such lambdas can be computed from the call-site operands.
+	*/
+	bool
+	is_internal(const lambda::node * lambda) const noexcept
+	{
+		return internal_.find(lambda) != internal_.end();
+	}
+
+	void
+	add_internal(const lambda::node * lambda)
+	{
+		internal_.insert(lambda);
+	}
+
+	/*
+		Registers \p call as a direct call of \p lambda. The call is reevaluated whenever one of
+		the lambda's results changes.
+	*/
+	void
+	add_call(const lambda::node * lambda, jive::node * call)
+	{
+		calls_[lambda].insert(call);
+	}
+
+	/*
+		Marks \p region as executable, and queues all its nodes for their first evaluation.
+	*/
+	void
+	mark_executable(jive::region * region)
+	{
+		if (!executable_.insert(region).second)
+			return;
+
+		for (auto & node : region->nodes)
+			push(&node);
+	}
+
+	bool
+	is_executable(const jive::region * region) const noexcept
+	{
+		return executable_.find(region) != executable_.end();
+	}
+
+	void
+	push(jive::node * node)
+	{
+		if (queued_.find(node) != queued_.end())
+			return;
+
+		worklist_.push_back(node);
+		queued_.insert(node);
+	}
+
+	jive::node *
+	pop() noexcept
+	{
+		JLM_ASSERT(!empty());
+		auto node = worklist_.front();
+		worklist_.pop_front();
+		queued_.erase(node);
+		return node;
+	}
+
+	bool
+	empty() const noexcept
+	{
+		JLM_ASSERT(worklist_.size() == queued_.size());
+		return worklist_.empty();
+	}
+
+private:
+	/*
+		Queues the nodes that read \p output. A result is read by the node of its region, except
+		for the results of a lambda, which are read by the lambda's direct calls.
+	*/
+	void
+	push_users(jive::output * output)
+	{
+		for (const auto & user : *output) {
+			if (!dynamic_cast<const jive::result*>(user)) {
+				push(input_node(user));
+				continue;
+			}
+
+			auto node = user->region()->node();
+			if (auto lambda = dynamic_cast<const lambda::node*>(node)) {
+				for (const auto & call : calls_[lambda])
+					push(call);
+			} else if (node != nullptr) {
+				push(node);
+			}
+		}
+	}
+
+	static bool
+	is_tracked(const jive::type & type) noexcept
+	{
+		return dynamic_cast<const jive::bittype*>(&type)
+		    || dynamic_cast<const jive::ctltype*>(&type);
+	}
+
+	cnstvalue top_;
+	cnstvalue bottom_;
+	std::unordered_set<const lambda::node*> internal_;
+	std::unordered_map<const jive::output*, cnstvalue> values_;
+	std::unordered_map<const lambda::node*, std::unordered_set<jive::node*>> calls_;
+	std::unordered_set<const jive::region*> executable_;
+	std::deque<jive::node*> worklist_;
+	std::unordered_set<jive::node*> queued_;
+};
+
+/* constant folding */
+
+static const jive::bitvalue_repr *
+bitvalue(const cnstvalue & value)
+{
+	auto op = dynamic_cast<const jive::bitconstant_op*>(&value.operation());
+	return op && op->value().is_known() ? &op->value() : nullptr;
+}
+
+static cnstvalue
+bitconstant(const jive::bitvalue_repr & value)
+{
+	if (!value.is_known())
+		return cnstvalue::bottom();
+
+	return cnstvalue::constant(jive::bitconstant_op(value));
+}
+
+static bool
+is_division(const jive::operation & op)
+{
+	return is<jive::bitudiv_op>(op)
+	    || is<jive::bitsdiv_op>(op)
+	    || is<jive::bitumod_op>(op)
+	    || is<jive::bitsmod_op>(op);
+}
+
+static cnstvalue
+fold_match(const jive::match_op & op, const jive::bitvalue_repr & value)
+{
+	if (value.nbits() > 64)
+		return cnstvalue::bottom();
+
+	auto v = value.to_uint();
+	auto alternative = op.default_alternative();
+	for (const auto & pair : op) {
+		if (pair.first == v) {
+			alternative = pair.second;
+			break;
+		}
+	}
+
+	return cnstvalue::constant(jive::ctlconstant_op(
+		jive::ctlvalue_repr(alternative, op.nalternatives())));
+}
+
+static cnstvalue
+fold_compare(
+	const jive::bitcompare_op & op,
+	const jive::bitvalue_repr & v1,
+	const jive::bitvalue_repr & v2)
+{
+	switch (op.reduce_constants(v1, v2)) {
+		case jive::compare_result::static_true:
+			return bitconstant(jive::bitvalue_repr(1, 1));
+		case jive::compare_result::static_false:
+			return bitconstant(jive::bitvalue_repr(1, 0));
+		default:
+			return cnstvalue::bottom();
+	}
+}
+
+/*
+	Folds a single-result operation with constant operands.
+*/
+static cnstvalue
+fold(const jive::operation & op, const std::vector<const cnstvalue*> & operands)
+{
+	if (operands.empty()) {
+		if (auto cop = dynamic_cast<const jive::bitconstant_op*>(&op))
+			return bitconstant(cop->value());
+
+		if (auto cop = dynamic_cast<const jive::ctlconstant_op*>(&op))
+			return cnstvalue::constant(*cop);
+
+		return cnstvalue::bottom();
+	}
+
+	if (operands.size() == 1) {
+		auto v = bitvalue(*operands[0]);
+		if (v == nullptr)
+			return cnstvalue::bottom();
+
+		if (auto mop = dynamic_cast<const jive::match_op*>(&op))
+			return fold_match(*mop, *v);
+
+		if (auto uop = dynamic_cast<const jive::bitunary_op*>(&op))
+			return bitconstant(uop->reduce_constant(*v));
+
+		if (auto zop = dynamic_cast<const zext_op*>(&op))
+			return bitconstant(v->zext(zop->ndstbits()-zop->nsrcbits()));
+
+		if (auto sop = dynamic_cast<const sext_op*>(&op))
+			return bitconstant(v->sext(sop->ndstbits()-sop->nsrcbits()));
+
+		return cnstvalue::bottom();
+	}
+
+	if (operands.size() == 2) {
+		auto v1 = bitvalue(*operands[0]);
+		auto v2 = bitvalue(*operands[1]);
+		if (v1 == nullptr || v2 == nullptr)
+			return cnstvalue::bottom();
+
+		if (is_division(op) && *v2 == 0)
+			return cnstvalue::bottom();
+
+		if (auto bop = dynamic_cast<const jive::bitbinary_op*>(&op))
+			return bitconstant(bop->reduce_constants(*v1, *v2));
+
+		if (auto cop = dynamic_cast<const jive::bitcompare_op*>(&op))
+			return fold_compare(*cop, *v1, *v2);
+	}
+
+	return cnstvalue::bottom();
+}
+
+/* analysis */
+
+static void
+analyze_call(jive::simple_node * node, sccpctx & ctx)
+{
+	JLM_ASSERT(is<call_op>(node));
+
+	auto lambda = is_direct_call(*node);
+	if (lambda == nullptr) {
+		for (size_t n = 0; n < node->noutputs(); n++)
+			ctx.lower(node->output(n), cnstvalue::bottom());
+		return;
+	}
+
+	ctx.add_call(lambda, node);
+	if (ctx.is_internal(lambda)) {
+		for (size_t n = 1; n < node->ninputs(); n++)
+			ctx.lower(lambda->fctargument(n-1), ctx.value(node->input(n)->origin()));
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++)
+		ctx.lower(node->output(n), ctx.value(lambda->fctresult(n)->origin()));
+}
+
+static void
+analyze_simple(jive::simple_node * node, sccpctx & ctx)
+{
+	if (is<call_op>(node))
+		return analyze_call(node, ctx);
+
+	bool all_constant = true;
+	std::vector<const cnstvalue*> operands;
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		auto & value = ctx.value(node->input(n)->origin());
+		/* results stay undefined as long as an operand is undefined */
+		if (value.is_top())
+			return;
+
+		all_constant &= value.is_constant();
+		operands.push_back(&value);
+	}
+
+	if (node->noutputs() == 1 && all_constant) {
+		ctx.lower(node->output(0), fold(node->operation(), operands));
+		return;
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++)
+		ctx.lower(node->output(n), cnstvalue::bottom());
+}
+
+static void
+analyze_gamma(jive::structural_node * node, sccpctx & ctx)
+{
+	JLM_ASSERT(is<jive::gamma_op>(node));
+	auto gamma = static_cast<jive::gamma_node*>(node);
+
+	auto & predicate = ctx.value(gamma->predicate()->origin());
+	if (predicate.is_top())
+		return;
+
+	/* collect executable subregions */
+	std::vector<jive::region*> subregions;
+	auto cop = predicate.is_constant()
+	         ? dynamic_cast<const jive::ctlconstant_op*>(&predicate.operation())
+	         : nullptr;
+	if (cop != nullptr) {
+		subregions.push_back(gamma->subregion(cop->value().alternative()));
+	} else {
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			subregions.push_back(gamma->subregion(n));
+	}
+
+	for (const auto & subregion : subregions) {
+		ctx.mark_executable(subregion);
+
+		for (size_t n = 0; n < subregion->narguments(); n++) {
+			auto argument = subregion->argument(n);
+			ctx.lower(argument, ctx.value(argument->input()->origin()));
+		}
+
+		for (size_t n = 0; n < subregion->nresults(); n++) {
+			auto result = subregion->result(n);
+			ctx.lower(result->output(), ctx.value(result->origin()));
+		}
+	}
+}
+
+static void
+analyze_theta(jive::structural_node * node, sccpctx & ctx)
+{
+	JLM_ASSERT(is<jive::theta_op>(node));
+	auto theta = static_cast<jive::theta_node*>(node);
+
+	ctx.mark_executable(theta->subregion());
+
+	/*
+		The theta is reevaluated whenever one of its results is lowered, such that the arguments
+		and outputs end up with the meet of the values of all iterations.
+	*/
+	for (const auto & lv : *theta) {
+		ctx.lower(lv->argument(), ctx.value(lv->input()->origin()));
+		ctx.lower(lv->argument(), ctx.value(lv->result()->origin()));
+		ctx.lower(lv, ctx.value(lv->result()->origin()));
+	}
+}
+
+static void
+analyze_lambda(jive::structural_node * node, sccpctx & ctx)
+{
+	JLM_ASSERT(is<lambda::operation>(node));
+	auto lambda = static_cast<lambda::node*>(node);
+
+	if (!ctx.is_internal(lambda)) {
+		for (auto & argument : lambda->fctarguments())
+			ctx.lower(&argument, cnstvalue::bottom());
+	}
+
+	for (auto & cv : lambda->ctxvars())
+		ctx.lower(cv.argument(), ctx.value(cv.origin()));
+
+	ctx.mark_executable(lambda->subregion());
+}
+
+static void
+analyze_phi(jive::structural_node * node, sccpctx & ctx)
+{
+	JLM_ASSERT(is<jive::phi::operation>(node));
+	auto subregion = node->subregion(0);
+	ctx.mark_executable(subregion);
+
+	for (size_t n = 0; n < subregion->narguments(); n++) {
+		auto argument = subregion->argument(n);
+		if (argument->input()) ctx.lower(argument, ctx.value(argument->input()->origin()));
+		else ctx.lower(argument, ctx.value(subregion->result(argument->index())->origin()));
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++)
+		ctx.lower(node->output(n), ctx.value(subregion->result(n)->origin()));
+}
+
+static void
+analyze_delta(jive::structural_node * node, sccpctx & ctx)
+{
+	JLM_ASSERT(is<delta::operation>(node));
+	ctx.lower(node->output(0), cnstvalue::bottom());
+}
+
+static void
+analyze(jive::structural_node * node, sccpctx & ctx)
+{
+	switch (get_opcode(node->operation())) {
+		case opcode::gamma_op:
+			return analyze_gamma(node, ctx);
+		case opcode::theta_op:
+			return analyze_theta(node, ctx);
+		case opcode::lambda:
+			return analyze_lambda(node, ctx);
+		case opcode::phi:
+			return analyze_phi(node, ctx);
+		case opcode::delta:
+			return analyze_delta(node, ctx);
+		default:
+			JLM_UNREACHABLE("Unhandled structural node.");
+	}
+}
+
+static void
+analyze(jive::node * node, sccpctx & ctx)
+{
+	if (auto simple = dynamic_cast<jive::simple_node*>(node))
+		analyze_simple(simple, ctx);
+	else
+		analyze(static_cast<jive::structural_node*>(node), ctx);
+}
+
+static void
+collect_internal_lambdas(jive::region * region, sccpctx & ctx)
+{
+	for (auto & node : region->nodes) {
+		if (auto lambda = dynamic_cast<const lambda::node*>(&node)) {
+			std::vector<jive::simple_node*> calls;
+			if (!lambda->direct_calls(&calls))
+				continue;
+
+			/*
+				A call could reach the lambda through a merge of several functions. Such a call does not
+				resolve to the lambda, and would never contribute its operands to the arguments.
+			*/
+			if (std::all_of(calls.begin(), calls.end(), [&](const jive::simple_node * call) {
+				return is_direct_call(*call) == lambda;
+			}))
+				ctx.add_internal(lambda);
+			continue;
+		}
+
+		if (is<jive::phi::operation>(&node))
+			collect_internal_lambdas(static_cast<jive::structural_node*>(&node)->subregion(0), ctx);
+	}
+}
+
+static void
+analyze(jive::graph & graph, sccpctx & ctx)
+{
+	auto root = graph.root();
+
+	collect_internal_lambdas(root, ctx);
+	for (size_t n = 0; n < root->narguments(); n++)
+		ctx.lower(root->argument(n), cnstvalue::bottom());
+
+	/*
+		Every node is evaluated once its region becomes executable. Afterwards, it is only
+		reevaluated if the value of one of its operands was lowered.
+	*/
+	ctx.mark_executable(root);
+	while (!ctx.empty()) {
+		auto node = ctx.pop();
+		if (ctx.is_executable(node->region()))
+			analyze(node, ctx);
+	}
+}
+
+/* transformation */
+
+static const jive::ctlconstant_op *
+is_constant_predicate(const jive::gamma_node * gamma, const sccpctx & ctx)
+{
+	auto & predicate = ctx.value(gamma->predicate()->origin());
+	if (!predicate.is_constant())
+		return nullptr;
+
+	return dynamic_cast<const jive::ctlconstant_op*>(&predicate.operation());
+}
+
+static void
+replace(jive::output * output, sccpctx & ctx)
+{
+	auto value = ctx.value(output);
+	if (!value.is_constant() || output->nusers() == 0)
+		return;
+
+	/* output is already produced by a constant */
+	auto node = jive::node_output::node(output);
+	if (is<jive::simple_op>(node) && node->ninputs() == 0)
+		return;
+
+	auto constant = jive::simple_node::create_normalized(output->region(), value.operation(), {})[0];
+	ctx.lower(constant, value);
+	output->divert_users(constant);
+}
+
+static void
+fold(jive::gamma_node * gamma, size_t alternative)
+{
+	auto subregion = gamma->subregion(alternative);
+
+	jive::substitution_map smap;
+	for (size_t n = 0; n < subregion->narguments(); n++) {
+		auto argument = subregion->argument(n);
+		smap.insert(argument, argument->input()->origin());
+	}
+
+	subregion->copy(gamma->region(), smap, false, false);
+
+	for (size_t n = 0; n < gamma->noutputs(); n++)
+		gamma->output(n)->divert_users(smap.lookup(subregion->result(n)->origin()));
+	remove(gamma);
+}
+
+static void
+transform(jive::region * region, sccpctx & ctx)
+{
+	for (size_t n = 0; n < region->narguments(); n++)
+		replace(region->argument(n), ctx);
+
+	std::vector<std::pair<jive::gamma_node*, size_t>> gammas;
+	for (const auto & node : jive::topdown_traverser(region)) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			auto gamma = dynamic_cast<jive::gamma_node*>(node);
+			if (auto cop = gamma ? is_constant_predicate(gamma, ctx) : nullptr) {
+				/* only the selected subregion is alive */
+				auto alternative = cop->value().alternative();
+				gammas.push_back(std::make_pair(gamma, alternative));
+				transform(gamma->subregion(alternative), ctx);
+			} else {
+				for (size_t n = 0; n < structnode->nsubregions(); n++)
+					transform(structnode->subregion(n), ctx);
+			}
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++)
+			replace(node->output(n), ctx);
+	}
+
+	for (const auto & pair : gammas)
+		fold(pair.first, pair.second);
+}
+
+static void
+sccp(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	sccpctx ctx;
+	sccpstat stat;
+
+	if (sd.print_sccp_stat)
+		stat.start_analysis_stat(graph);
+	analyze(graph, ctx);
+	stat.end_analysis_stat();
+
+	stat.start_transformation_stat();
+	transform(graph.root(), ctx);
+	if (sd.print_sccp_stat) {
+		stat.end_transformation_stat(graph);
+		sd.print_stat(stat);
+	}
+}
+
+/* sccp class */
+
+sccp::~sccp()
+{}
+
+void
+sccp::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	jlm::sccp(module, sd);
+}
+
+}
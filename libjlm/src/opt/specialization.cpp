@@ -0,0 +1,325 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/inlining.hpp>
+#include <jlm/opt/specialization.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/types/bitstring/constant.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/substitution.hpp>
+#include <jive/rvsdg/traverser.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace jlm {
+
+class spcstat final : public stat {
+public:
+	virtual
+	~spcstat()
+	{}
+
+	spcstat()
+	: nclones_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nclones) noexcept
+	{
+		nclones_ = nclones;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("SPC ", nnodes_before_, " ", nnodes_after_, " ", nclones_, " ", timer_.ns());
+	}
+
+private:
+	size_t nclones_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/*
+	Traces an operand of a call through gamma arguments, invariant theta arguments, and lambda
+	and phi context variables to a bit or control constant.
+*/
+static const jive::simple_node *
+trace_constant(const jive::output * output)
+{
+	while (true) {
+		if (is<lambda::cvargument>(output) || is_gamma_argument(output) || is_phi_cv(output)) {
+			output = static_cast<const jive::argument*>(output)->input()->origin();
+			continue;
+		}
+
+		if (auto argument = is_theta_argument(output)) {
+			auto loopvar = static_cast<const jive::theta_input*>(argument->input())->output();
+			if (loopvar->result()->origin() != argument)
+				return nullptr;
+
+			output = argument->input()->origin();
+			continue;
+		}
+
+		break;
+	}
+
+	auto node = jive::node_output::node(output);
+	if (is<jive::bitconstant_op>(node) || is<jive::ctlconstant_op>(node))
+		return static_cast<const jive::simple_node*>(node);
+
+	return nullptr;
+}
+
+/*
+	A group of direct calls that pass the same constants. The constants are indexed by function
+	argument, and are NULL for arguments that are not constant.
+*/
+class callgroup final {
+public:
+	callgroup(std::vector<const jive::simple_node*> constants)
+	: constants(std::move(constants))
+	{}
+
+	bool
+	matches(const std::vector<const jive::simple_node*> & other) const noexcept
+	{
+		JLM_ASSERT(constants.size() == other.size());
+
+		for (size_t n = 0; n < constants.size(); n++) {
+			if (constants[n] == nullptr && other[n] == nullptr)
+				continue;
+
+			if (constants[n] == nullptr || other[n] == nullptr)
+				return false;
+
+			if (constants[n]->operation() != other[n]->operation())
+				return false;
+		}
+
+		return true;
+	}
+
+	std::vector<const jive::simple_node*> constants;
+	std::vector<jive::simple_node*> calls;
+};
+
+static std::vector<callgroup>
+group_calls(const lambda::node & lambda, const std::vector<jive::simple_node*> & calls)
+{
+	std::vector<callgroup> groups;
+	for (const auto & call : calls) {
+		/*
+			Only constants for used arguments are of interest, as they are the only ones that
+			enable further optimizations in the specialized lambda.
+		*/
+		bool hasconstants = false;
+		std::vector<const jive::simple_node*> constants(lambda.nfctarguments(), nullptr);
+		for (size_t n = 0; n < lambda.nfctarguments(); n++) {
+			if (lambda.fctargument(n)->nusers() == 0)
+				continue;
+
+			constants[n] = trace_constant(call->input(n+1)->origin());
+			hasconstants = hasconstants || constants[n] != nullptr;
+		}
+
+		if (!hasconstants)
+			continue;
+
+		auto it = std::find_if(groups.begin(), groups.end(), [&](const callgroup & group) {
+			return group.matches(constants);
+		});
+		if (it == groups.end()) {
+			groups.push_back(callgroup(std::move(constants)));
+			it = std::prev(groups.end());
+		}
+
+		it->calls.push_back(call);
+	}
+
+	std::stable_sort(groups.begin(), groups.end(), [](const callgroup & g1, const callgroup & g2) {
+		return g1.calls.size() > g2.calls.size();
+	});
+
+	return groups;
+}
+
+static lambda::node *
+specialize(
+	const lambda::node & lambda,
+	const std::vector<const jive::simple_node*> & constants,
+	const std::string & name)
+{
+	auto clone = lambda::node::create(lambda.region(), lambda.type(), name,
+		linkage::internal_linkage, lambda.attributes());
+
+	jive::substitution_map smap;
+	for (auto & cv : lambda.ctxvars())
+		smap.insert(cv.argument(), clone->add_ctxvar(cv.origin()));
+
+	for (size_t n = 0; n < lambda.nfctarguments(); n++) {
+		auto argument = lambda.fctargument(n);
+		clone->fctargument(n)->set_attributes(argument->attributes());
+
+		auto output = constants[n]
+		            ? constants[n]->copy(clone->subregion(), {})->output(0)
+		            : clone->fctargument(n);
+		smap.insert(argument, output);
+	}
+
+	lambda.subregion()->copy(clone->subregion(), smap, false, false);
+
+	std::vector<jive::output*> results;
+	for (auto & result : lambda.fctresults())
+		results.push_back(smap.lookup(result.origin()));
+
+	clone->finalize(results);
+
+	return clone;
+}
+
+/*
+	Collects the names of all lambdas, deltas, and imports of \p graph, such that the names of
+	specialized lambdas do not clash with any of them.
+*/
+static std::unordered_set<std::string>
+collect_names(const jive::graph & graph)
+{
+	std::unordered_set<std::string> names;
+	for (size_t n = 0; n < graph.root()->narguments(); n++) {
+		auto argument = graph.root()->argument(n);
+		names.insert(static_cast<const jlm::impport*>(&argument->port())->name());
+	}
+
+	std::vector<const jive::region*> regions({graph.root()});
+	while (!regions.empty()) {
+		auto region = regions.back();
+		regions.pop_back();
+
+		for (const auto & node : region->nodes) {
+			if (auto lambda = dynamic_cast<const lambda::node*>(&node))
+				names.insert(lambda->name());
+			else if (auto delta = dynamic_cast<const delta::node*>(&node))
+				names.insert(delta->name());
+
+			if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+				for (size_t n = 0; n < structnode->nsubregions(); n++)
+					regions.push_back(structnode->subregion(n));
+			}
+		}
+	}
+
+	return names;
+}
+
+static std::string
+create_name(const std::string & name, std::unordered_set<std::string> & names)
+{
+	size_t n = 0;
+	while (names.find(strfmt(name, ".spec", n)) != names.end())
+		n++;
+
+	auto unique = strfmt(name, ".spec", n);
+	names.insert(unique);
+	return unique;
+}
+
+static size_t
+specialize(
+	jive::region * region,
+	size_t & budget,
+	size_t mincalls,
+	std::unordered_set<std::string> & names)
+{
+	/*
+		Collect the lambdas first, since the specialized lambdas are added to the same region. The
+		lambdas of phi regions are not specialized, as a specialized lambda would require its own
+		recursion variable in order to be part of the phi.
+	*/
+	std::vector<const lambda::node*> lambdas;
+	for (const auto & node : jive::topdown_traverser(region)) {
+		if (auto lambda = dynamic_cast<const lambda::node*>(node))
+			lambdas.push_back(lambda);
+	}
+
+	size_t nclones = 0;
+	for (const auto & lambda : lambdas) {
+		std::vector<jive::simple_node*> calls;
+		if (!lambda->direct_calls(&calls))
+			continue;
+
+		if (std::any_of(calls.begin(), calls.end(), [&](const jive::simple_node * call) {
+			return is_direct_call(*call) != lambda;
+		}))
+			continue;
+
+		size_t cost = jive::nnodes(lambda->subregion());
+		for (const auto & group : group_calls(*lambda, calls)) {
+			/* groups are sorted by their number of calls */
+			if (cost > budget || group.calls.size() < mincalls)
+				break;
+
+			auto clone = specialize(*lambda, group.constants, create_name(lambda->name(), names));
+			for (const auto & call : group.calls)
+				call->input(0)->divert_to(route_to_region(clone->output(), call->region()));
+
+			budget -= cost;
+			nclones++;
+		}
+	}
+
+	return nclones;
+}
+
+static void
+specialize(
+	rvsdg_module & rm,
+	const stats_descriptor & sd,
+	size_t budget,
+	size_t mincalls)
+{
+	auto & graph = *rm.graph();
+
+	spcstat stat;
+	stat.start(graph);
+	auto names = collect_names(graph);
+	auto nclones = specialize(graph.root(), budget, mincalls, names);
+	stat.end(graph, nclones);
+
+	if (sd.print_specialization_stat)
+		sd.print_stat(stat);
+}
+
+/* fctspecialization class */
+
+fctspecialization::~fctspecialization()
+{}
+
+void
+fctspecialization::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	specialize(module, sd, budget_, mincalls_);
+}
+
+}
@@ -0,0 +1,702 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/inlining.hpp>
+#include <jlm/opt/sroa.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+#include <jive/types/record.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace jlm {
+
+class sroastat final : public stat {
+public:
+	virtual
+	~sroastat()
+	{}
+
+	sroastat()
+	: nsplit_(0)
+	, npromoted_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nsplit, size_t npromoted) noexcept
+	{
+		nsplit_ = nsplit;
+		npromoted_ = npromoted;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("SROA ",
+			nnodes_before_, " ", nnodes_after_, " ",
+			nsplit_, " ", npromoted_, " ",
+			timer_.ns()
+		);
+	}
+
+private:
+	size_t nsplit_;
+	size_t npromoted_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/* address uses */
+
+/*
+	Collects the uses of \p address. Addresses passed into gammas and thetas are followed into
+	their subregions, and all outputs that carry the address are added to \p addresses. Returns
+	false if the address is passed to any other structural node or is a varying loop variable.
+*/
+static bool
+collect_uses(
+	jive::output * address,
+	std::unordered_set<jive::output*> & addresses,
+	std::vector<jive::input*> & uses)
+{
+	addresses.insert(address);
+
+	for (const auto & user : *address) {
+		if (auto input = dynamic_cast<jive::gamma_input*>(user)) {
+			auto gamma = static_cast<jive::gamma_node*>(input->node());
+			for (size_t n = 0; n < gamma->nsubregions(); n++) {
+				if (!collect_uses(input->argument(n), addresses, uses))
+					return false;
+			}
+			continue;
+		}
+
+		if (auto input = dynamic_cast<jive::theta_input*>(user)) {
+			if (!is_invariant(input)
+			|| !collect_uses(input->argument(), addresses, uses)
+			|| !collect_uses(input->output(), addresses, uses))
+				return false;
+			continue;
+		}
+
+		/*
+			The result of an invariant loop variable only passes the address on to the next
+			iteration.
+		*/
+		auto argument = dynamic_cast<jive::argument*>(address);
+		auto theta = argument ? dynamic_cast<jive::theta_node*>(argument->region()->node()) : nullptr;
+		if (theta && user == static_cast<jive::theta_input*>(argument->input())->result())
+			continue;
+
+		if (dynamic_cast<jive::structural_input*>(user) || dynamic_cast<jive::result*>(user))
+			return false;
+
+		uses.push_back(user);
+	}
+
+	return true;
+}
+
+static bool
+has_unit_size(const jive::node * alloca)
+{
+	auto node = jive::node_output::node(alloca->input(0)->origin());
+	if (!is<jive::bitconstant_op>(node))
+		return false;
+
+	auto op = static_cast<const jive::bitconstant_op*>(&node->operation());
+	return op->value().is_known() && op->value().to_uint() == 1;
+}
+
+static const jive::bitconstant_op *
+is_constant(const jive::input * input)
+{
+	auto node = jive::node_output::node(input->origin());
+	if (!is<jive::bitconstant_op>(node))
+		return nullptr;
+
+	auto op = static_cast<const jive::bitconstant_op*>(&node->operation());
+	return op->value().is_known() ? op : nullptr;
+}
+
+/* aggregate splitting */
+
+static std::vector<const jive::valuetype*>
+element_types(const jive::valuetype & type)
+{
+	std::vector<const jive::valuetype*> types;
+	if (auto st = dynamic_cast<const structtype*>(&type)) {
+		auto dcl = st->declaration();
+		for (size_t n = 0; n < dcl->nelements(); n++)
+			types.push_back(&dcl->element(n));
+	} else if (auto at = dynamic_cast<const arraytype*>(&type)) {
+		for (size_t n = 0; n < at->nelements(); n++)
+			types.push_back(&at->element_type());
+	}
+
+	return types;
+}
+
+/*
+	Checks whether \p address of type \p type is only used as the address of loads and stores
+	of \p type. Bitcasts and getelementptrs with constant indices that stay within the pointee
+	are followed, such that an element address cannot escape the element, e.g., by indexing a
+	decayed array.
+*/
+static bool
+is_address_only(jive::output * address, const jive::valuetype & type)
+{
+	std::unordered_set<jive::output*> addresses;
+	std::vector<jive::input*> uses;
+	if (!collect_uses(address, addresses, uses))
+		return false;
+
+	for (const auto & use : uses) {
+		auto node = input_node(use);
+		if (use->index() != 0)
+			return false;
+
+		if (is<bitcast_op>(node)) {
+			if (!is_address_only(node->output(0), type))
+				return false;
+			continue;
+		}
+
+		if (auto op = dynamic_cast<const load_op*>(&node->operation())) {
+			if (op->pointee_type() != type)
+				return false;
+			continue;
+		}
+
+		if (auto op = dynamic_cast<const store_op*>(&node->operation())) {
+			if (op->value_type() != type)
+				return false;
+			continue;
+		}
+
+		if (auto op = dynamic_cast<const getelementptr_op*>(&node->operation())) {
+			if (op->pointee_type() != type || node->ninputs() < 2)
+				return false;
+
+			for (size_t n = 1; n < node->ninputs(); n++) {
+				if (!is_constant(node->input(n)))
+					return false;
+			}
+
+			if (is_constant(node->input(1))->value().to_uint() != 0)
+				return false;
+
+			auto & pt = *static_cast<const ptrtype*>(&node->output(0)->type());
+			if (!is_address_only(node->output(0), pt.pointee_type()))
+				return false;
+			continue;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+	Checks whether all uses of the aggregate are getelementptrs with constant indices that
+	select an element of the aggregate, and whose results are only used as addresses of this
+	element. Returns the element selected by each getelementptr.
+*/
+static bool
+is_splittable(
+	const std::vector<jive::input*> & uses,
+	const std::vector<const jive::valuetype*> & types,
+	std::vector<std::pair<jive::node*, size_t>> & geps)
+{
+	for (const auto & use : uses) {
+		auto gep = input_node(use);
+		if (!is<getelementptr_op>(gep) || use->index() != 0 || gep->ninputs() < 3)
+			return false;
+
+		for (size_t n = 1; n < gep->ninputs(); n++) {
+			if (!is_constant(gep->input(n)))
+				return false;
+		}
+
+		auto first = is_constant(gep->input(1))->value().to_uint();
+		auto element = is_constant(gep->input(2))->value().to_uint();
+		if (first != 0 || element >= types.size())
+			return false;
+
+		if (gep->ninputs() == 3 && gep->output(0)->type() != ptrtype(*types[element]))
+			return false;
+
+		auto & pt = *static_cast<const ptrtype*>(&gep->output(0)->type());
+		if (!is_address_only(gep->output(0), pt.pointee_type()))
+			return false;
+
+		geps.push_back({gep, element});
+	}
+
+	return true;
+}
+
+/*
+	Splits the aggregate \p alloca and adds the allocas of its elements to \p allocas.
+*/
+static bool
+split(jive::node * alloca, std::vector<jive::node*> & allocas)
+{
+	auto op = static_cast<const alloca_op*>(&alloca->operation());
+	auto types = element_types(op->value_type());
+	if (types.empty() || !has_unit_size(alloca))
+		return false;
+
+	std::unordered_set<jive::output*> addresses;
+	std::vector<jive::input*> uses;
+	std::vector<std::pair<jive::node*, size_t>> geps;
+	if (!collect_uses(alloca->output(0), addresses, uses)
+	|| !is_splittable(uses, types, geps))
+		return false;
+
+	std::vector<jive::output*> elements, states;
+	for (const auto & type : types) {
+		auto outputs = alloca_op::create(*type, alloca->input(0)->origin(), op->alignment());
+		elements.push_back(outputs[0]);
+		states.push_back(outputs[1]);
+		allocas.push_back(jive::node_output::node(outputs[0]));
+	}
+	alloca->output(1)->divert_users(memstatemux_op::create_merge(states));
+
+	for (const auto & p : geps) {
+		auto gep = p.first;
+		auto address = route_to_region(elements[p.second], gep->region());
+
+		if (gep->ninputs() == 3) {
+			gep->output(0)->divert_users(address);
+			continue;
+		}
+
+		std::vector<jive::output*> indices({gep->input(1)->origin()});
+		for (size_t n = 3; n < gep->ninputs(); n++)
+			indices.push_back(gep->input(n)->origin());
+
+		auto output = getelementptr_op::create(address, indices, gep->output(0)->type());
+		gep->output(0)->divert_users(output);
+	}
+
+	return true;
+}
+
+/* alloca promotion */
+
+/*
+	Computes the values of an alloca at its memory states. A promoter in dry mode does not
+	modify the graph. It represents each value it would create by the output it would be
+	created for, such that it succeeds exactly if the same computation in non-dry mode does.
+*/
+class promoter final {
+public:
+	promoter(
+		jive::node * alloca,
+		const std::unordered_set<jive::output*> & addresses,
+		bool dry)
+	: dry_(dry)
+	, alloca_(alloca)
+	, addresses_(addresses)
+	{}
+
+	/*
+		Returns the value of the alloca at memory state \p state, or nullptr if it cannot be
+		determined.
+	*/
+	jive::output *
+	value(jive::output * state)
+	{
+		auto it = values_.find(state);
+		if (it != values_.end())
+			return it->second;
+
+		auto v = compute(state);
+		values_[state] = v;
+		return v;
+	}
+
+	/*
+		Connects the results of the loop variables that were added to thetas.
+	*/
+	bool
+	finalize()
+	{
+		while (!pending_.empty()) {
+			auto lv = pending_.back().first;
+			auto result = pending_.back().second;
+			pending_.pop_back();
+
+			auto v = value(result->origin());
+			if (v == nullptr)
+				return false;
+
+			if (!dry_)
+				lv->result()->divert_to(v);
+		}
+
+		return true;
+	}
+
+private:
+	const jive::valuetype &
+	type() const noexcept
+	{
+		return static_cast<const alloca_op*>(&alloca_->operation())->value_type();
+	}
+
+	jive::output *
+	undef(jive::output * key)
+	{
+		auto v = dry_ ? key : undef_constant_op::create(key->region(), type());
+		undefs_.insert(v);
+		return v;
+	}
+
+	jive::output *
+	compute(jive::output * state)
+	{
+		if (state == alloca_->output(1))
+			return undef(state);
+
+		if (auto argument = dynamic_cast<jive::argument*>(state))
+			return compute_argument(argument);
+
+		auto node = jive::node_output::node(state);
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			std::vector<jive::output*> values;
+			for (size_t n = 0; n < gamma->nsubregions(); n++) {
+				auto v = value(gamma->subregion(n)->result(state->index())->origin());
+				if (v == nullptr)
+					return nullptr;
+				values.push_back(v);
+			}
+
+			return dry_ ? state : gamma->add_exitvar(values);
+		}
+
+		if (is<jive::theta_op>(node)) {
+			auto lv = static_cast<jive::theta_output*>(state);
+			if (value(lv->argument()) == nullptr)
+				return nullptr;
+
+			return values_[lv];
+		}
+
+		if (is<store_op>(node)) {
+			if (addresses_.find(node->input(0)->origin()) != addresses_.end())
+				return node->input(1)->origin();
+
+			return value(node->input(state->index()+2)->origin());
+		}
+
+		if (is<load_op>(node))
+			return value(node->input(state->index())->origin());
+
+		if (is<memstatemux_op>(node))
+			return compute_mux(node);
+
+		if (dynamic_cast<const jive::simple_node*>(node)) {
+			jive::input * input = nullptr;
+			for (size_t n = 0; n < node->ninputs(); n++) {
+				if (dynamic_cast<const jive::memtype*>(&node->input(n)->type())) {
+					if (input != nullptr)
+						return nullptr;
+					input = node->input(n);
+				}
+			}
+
+			return input ? value(input->origin()) : nullptr;
+		}
+
+		return nullptr;
+	}
+
+	jive::output *
+	compute_argument(jive::argument * argument)
+	{
+		auto node = argument->region()->node();
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			auto input = static_cast<jive::gamma_input*>(argument->input());
+			auto v = value(input->origin());
+			if (v == nullptr)
+				return nullptr;
+
+			auto ev = dry_ ? input : gamma->add_entryvar(v);
+			for (size_t n = 0; n < gamma->nsubregions(); n++) {
+				values_[input->argument(n)] = ev->argument(n);
+				if (undefs_.find(v) != undefs_.end())
+					undefs_.insert(ev->argument(n));
+			}
+
+			return ev->argument(argument->region()->index());
+		}
+
+		if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+			auto input = static_cast<jive::theta_input*>(argument->input());
+			auto v = value(input->origin());
+			if (v == nullptr)
+				return nullptr;
+
+			auto lv = dry_ ? input->output() : theta->add_loopvar(v);
+			values_[input->output()] = lv;
+			pending_.push_back({lv, input->result()});
+			return lv->argument();
+		}
+
+		/*
+			The alloca does not exist outside of its region.
+		*/
+		return undef(argument);
+	}
+
+	/*
+		A merge of memory states has the value of its only operand with a defined value.
+	*/
+	jive::output *
+	compute_mux(jive::node * node)
+	{
+		if (node->ninputs() == 1)
+			return value(node->input(0)->origin());
+
+		if (node->noutputs() != 1)
+			return nullptr;
+
+		jive::output * v = nullptr;
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto operand = value(node->input(n)->origin());
+			if (operand == nullptr)
+				return nullptr;
+
+			if (undefs_.find(operand) != undefs_.end() || operand == v)
+				continue;
+
+			if (v != nullptr)
+				return nullptr;
+			v = operand;
+		}
+
+		return v ? v : undef(node->output(0));
+	}
+
+	bool dry_;
+	jive::node * alloca_;
+	const std::unordered_set<jive::output*> & addresses_;
+	std::unordered_set<jive::output*> undefs_;
+	std::unordered_map<jive::output*, jive::output*> values_;
+	std::vector<std::pair<jive::theta_output*, jive::result*>> pending_;
+};
+
+static bool
+is_promotable(const jive::node * alloca, const std::vector<jive::input*> & uses)
+{
+	auto & type = static_cast<const alloca_op*>(&alloca->operation())->value_type();
+	for (const auto & use : uses) {
+		auto node = input_node(use);
+		if (use->index() != 0)
+			return false;
+
+		if (auto op = dynamic_cast<const load_op*>(&node->operation())) {
+			if (op->pointee_type() != type)
+				return false;
+			continue;
+		}
+
+		if (auto op = dynamic_cast<const store_op*>(&node->operation())) {
+			if (op->value_type() != type)
+				return false;
+			continue;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+	Removes the state of the alloca from the memory state merges that consume it.
+*/
+static void
+remove_state(jive::node * alloca)
+{
+	std::vector<jive::node*> muxes;
+	for (const auto & user : *alloca->output(1)) {
+		auto node = input_node(user);
+		if (!is<memstatemux_op>(node) || node->ninputs() < 2)
+			return;
+		muxes.push_back(node);
+	}
+
+	for (const auto & mux : muxes) {
+		std::vector<jive::output*> operands;
+		for (size_t n = 0; n < mux->ninputs(); n++) {
+			if (mux->input(n)->origin() != alloca->output(1))
+				operands.push_back(mux->input(n)->origin());
+		}
+
+		if (operands.size() == 1 && mux->noutputs() == 1) {
+			mux->output(0)->divert_users(operands[0]);
+			continue;
+		}
+
+		auto outputs = memstatemux_op::create(operands, mux->noutputs());
+		for (size_t n = 0; n < mux->noutputs(); n++)
+			mux->output(n)->divert_users(outputs[n]);
+	}
+}
+
+/*
+	Computes the values of all loads among \p uses and the results of the added loop
+	variables. Returns false if any of them cannot be determined.
+*/
+static bool
+compute_loads(
+	promoter && p,
+	const std::vector<jive::input*> & uses,
+	std::vector<std::pair<jive::node*, jive::output*>> & loads)
+{
+	for (const auto & use : uses) {
+		auto node = input_node(use);
+		if (!is<load_op>(node))
+			continue;
+
+		auto v = p.value(node->input(1)->origin());
+		if (v == nullptr)
+			return false;
+
+		for (size_t n = 2; n < node->ninputs(); n++) {
+			if (p.value(node->input(n)->origin()) != v)
+				return false;
+		}
+
+		loads.push_back({node, v});
+	}
+
+	return p.finalize();
+}
+
+static bool
+promote(jive::node * alloca)
+{
+	std::unordered_set<jive::output*> addresses;
+	std::vector<jive::input*> uses;
+	if (!collect_uses(alloca->output(0), addresses, uses) || !is_promotable(alloca, uses))
+		return false;
+
+	/*
+		Check that the values of all loads can be computed before the graph is modified.
+	*/
+	std::vector<std::pair<jive::node*, jive::output*>> loads;
+	if (!compute_loads(promoter(alloca, addresses, true), uses, loads))
+		return false;
+
+	loads.clear();
+	auto computed = compute_loads(promoter(alloca, addresses, false), uses, loads);
+	JLM_ASSERT(computed);
+
+	for (const auto & load : loads) {
+		auto node = load.first;
+		node->output(0)->divert_users(load.second);
+		for (size_t n = 1; n < node->noutputs(); n++)
+			node->output(n)->divert_users(node->input(n)->origin());
+	}
+
+	for (const auto & use : uses) {
+		auto node = input_node(use);
+		if (!is<store_op>(node))
+			continue;
+
+		for (size_t n = 0; n < node->noutputs(); n++)
+			node->output(n)->divert_users(node->input(n+2)->origin());
+	}
+
+	remove_state(alloca);
+	return true;
+}
+
+static void
+collect_allocas(jive::region * region, std::vector<jive::node*> & allocas)
+{
+	for (auto & node : region->nodes) {
+		if (is<alloca_op>(&node))
+			allocas.push_back(&node);
+
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_allocas(structnode->subregion(n), allocas);
+		}
+	}
+}
+
+static void
+sroa(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	sroastat stat;
+	stat.start(graph);
+
+	/*
+		Split the aggregates first such that the allocas of their elements can be promoted.
+		Elements that are aggregates themselves are split again.
+	*/
+	size_t nsplit = 0;
+	std::vector<jive::node*> allocas;
+	collect_allocas(graph.root(), allocas);
+	while (!allocas.empty()) {
+		auto alloca = allocas.back();
+		allocas.pop_back();
+
+		if (split(alloca, allocas))
+			nsplit++;
+	}
+
+	size_t npromoted = 0;
+	collect_allocas(graph.root(), allocas);
+	for (const auto & alloca : allocas) {
+		if (promote(alloca))
+			npromoted++;
+	}
+
+	stat.end(graph, nsplit, npromoted);
+
+	if (sd.print_sroa_stat)
+		sd.print_stat(stat);
+}
+
+/* sroa class */
+
+sroa::~sroa()
+{}
+
+void
+sroa::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	jlm::sroa(module, sd);
+}
+
+}
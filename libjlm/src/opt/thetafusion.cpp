@@ -0,0 +1,431 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/thetafusion.hpp>
+#include <jlm/opt/unroll.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/substitution.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <unordered_set>
+
+namespace jlm {
+
+class tfsstat final : public stat {
+public:
+	virtual
+	~tfsstat()
+	{}
+
+	tfsstat()
+	: nthetas_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nthetas) noexcept
+	{
+		nthetas_ = nthetas;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("TFS ", nnodes_before_, " ", nnodes_after_, " ", nthetas_, " ", timer_.ns());
+	}
+
+private:
+	size_t nthetas_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/* induction range */
+
+static bool
+is_equal(jive::output * o1, const jive::bitvalue_repr * v1, jive::output * o2,
+	const jive::bitvalue_repr * v2)
+{
+	if (o1 == o2)
+		return true;
+
+	return v1 && v2 && v1->nbits() == v2->nbits() && v1->to_uint() == v2->to_uint();
+}
+
+static bool
+has_same_range(const unrollinfo & ui1, const unrollinfo & ui2)
+{
+	auto match1 = jive::node_output::node(ui1.theta()->predicate()->origin());
+	auto match2 = jive::node_output::node(ui2.theta()->predicate()->origin());
+	if (match1->operation() != match2->operation())
+		return false;
+
+	if (ui1.cmpoperation() != ui2.cmpoperation()
+	|| ui1.armoperation() != ui2.armoperation())
+		return false;
+
+	/*
+		The operands of the comparison and the arithmetic operation must be in the same order.
+	*/
+	if ((ui1.cmpnode()->input(0)->origin() == ui1.end())
+	!= (ui2.cmpnode()->input(0)->origin() == ui2.end()))
+		return false;
+
+	if ((ui1.armnode()->input(0)->origin() == ui1.idv())
+	!= (ui2.armnode()->input(0)->origin() == ui2.idv()))
+		return false;
+
+	return is_equal(ui1.init(), ui1.init_value(), ui2.init(), ui2.init_value())
+	    && is_equal(ui1.step()->input()->origin(), ui1.step_value(),
+	                ui2.step()->input()->origin(), ui2.step_value())
+	    && is_equal(ui1.end()->input()->origin(), ui1.end_value(),
+	                ui2.end()->input()->origin(), ui2.end_value());
+}
+
+/* memory accesses */
+
+class accesses final {
+public:
+	/*
+		Returns false if the body of the theta contains nodes with state operands that are
+		neither loads nor stores.
+	*/
+	bool
+	collect(const jive::theta_node * theta)
+	{
+		for (auto & node : theta->subregion()->nodes) {
+			if (is<load_op>(&node)) {
+				loads.push_back(&node);
+				continue;
+			}
+
+			if (is<store_op>(&node)) {
+				stores.push_back(&node);
+				continue;
+			}
+
+			for (size_t n = 0; n < node.ninputs(); n++) {
+				if (dynamic_cast<const jive::statetype*>(&node.input(n)->type()))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<const jive::node*> loads;
+	std::vector<const jive::node*> stores;
+};
+
+/*
+	Returns the getelementptr node that computes the address of the load or store \p node if it
+	indexes a loop-invariant base with constant indices and the induction variable as last
+	index.
+*/
+static const jive::node *
+indexed_address(const jive::node * node, const unrollinfo & ui)
+{
+	auto gep = jive::node_output::node(node->input(0)->origin());
+	if (!is<getelementptr_op>(gep) || gep->ninputs() < 2)
+		return nullptr;
+
+	if (gep->input(gep->ninputs()-1)->origin() != ui.idv())
+		return nullptr;
+
+	for (size_t n = 1; n < gep->ninputs()-1; n++) {
+		if (!is<jive::bitconstant_op>(jive::node_output::node(gep->input(n)->origin())))
+			return nullptr;
+	}
+
+	auto base = dynamic_cast<jive::argument*>(gep->input(0)->origin());
+	if (base == nullptr || !is_invariant(static_cast<const jive::theta_input*>(base->input())))
+		return nullptr;
+
+	return gep;
+}
+
+static jive::output *
+base(const jive::node * gep)
+{
+	return static_cast<jive::argument*>(gep->input(0)->origin())->input()->origin();
+}
+
+/*
+	Allocas, deltas, and imports are distinct memory objects.
+*/
+static bool
+is_object(jive::output * output)
+{
+	return is<alloca_op>(jive::node_output::node(output))
+	    || dynamic_cast<const delta::output*>(output)
+	    || (dynamic_cast<const jive::argument*>(output)
+	        && output->region() == output->region()->graph()->root());
+}
+
+static bool
+is_independent(const jive::node * gep1, const jive::node * gep2)
+{
+	auto b1 = base(gep1);
+	auto b2 = base(gep2);
+	if (b1 != b2)
+		return is_object(b1) && is_object(b2);
+
+	if (gep1->operation() != gep2->operation())
+		return false;
+
+	for (size_t n = 1; n < gep1->ninputs()-1; n++) {
+		auto c1 = jive::node_output::node(gep1->input(n)->origin());
+		auto c2 = jive::node_output::node(gep2->input(n)->origin());
+		if (c1->operation() != c2->operation())
+			return false;
+	}
+
+	return true;
+}
+
+static bool
+is_independent(
+	const std::vector<const jive::node*> & stores,
+	const unrollinfo & ui1,
+	const accesses & a2,
+	const unrollinfo & ui2)
+{
+	std::vector<const jive::node*> nodes(a2.loads);
+	nodes.insert(nodes.end(), a2.stores.begin(), a2.stores.end());
+
+	for (const auto & store : stores) {
+		auto gep1 = indexed_address(store, ui1);
+		if (gep1 == nullptr)
+			return false;
+
+		for (const auto & node : nodes) {
+			auto gep2 = indexed_address(node, ui2);
+			if (gep2 == nullptr || !is_independent(gep1, gep2))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static bool
+has_independent_memory(const unrollinfo & ui1, const unrollinfo & ui2)
+{
+	accesses a1, a2;
+	if (!a1.collect(ui1.theta()) || !a2.collect(ui2.theta()))
+		return false;
+
+	return is_independent(a1.stores, ui1, a2, ui2)
+	    && is_independent(a2.stores, ui2, a1, ui1);
+}
+
+/* dependencies */
+
+static bool
+depends_on(jive::output * origin, const jive::node * node)
+{
+	std::unordered_set<jive::node*> visited;
+	std::vector<jive::output*> worklist({origin});
+	while (!worklist.empty()) {
+		auto producer = jive::node_output::node(worklist.back());
+		worklist.pop_back();
+
+		if (producer == node)
+			return true;
+
+		if (producer == nullptr || visited.find(producer) != visited.end())
+			continue;
+		visited.insert(producer);
+
+		for (size_t n = 0; n < producer->ninputs(); n++)
+			worklist.push_back(producer->input(n)->origin());
+	}
+
+	return false;
+}
+
+static bool
+depends_on(const jive::theta_node * t2, const jive::theta_node * t1)
+{
+	for (const auto & lv : *t2) {
+		if (depends_on(lv->input()->origin(), t1))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+	Theta \p t2 can only be fused after theta \p t1 if it depends on \p t1 only through states
+	that are directly passed from \p t1 to \p t2.
+*/
+static bool
+has_fusable_dependencies(const jive::theta_node * t1, const jive::theta_node * t2)
+{
+	for (const auto & lv : *t2) {
+		auto origin = lv->input()->origin();
+		if (jive::node_output::node(origin) == t1) {
+			if (!dynamic_cast<const jive::statetype*>(&origin->type()) || origin->nusers() != 1)
+				return false;
+			continue;
+		}
+
+		if (depends_on(origin, t1))
+			return false;
+	}
+
+	return true;
+}
+
+/* fusion */
+
+static void
+fuse(jive::theta_node * t1, jive::theta_node * t2)
+{
+	auto theta = jive::theta_node::create(t1->region());
+
+	jive::substitution_map smap;
+	std::unordered_map<jive::output*, jive::theta_output*> lvs;
+	for (const auto & olv : *t1) {
+		auto nlv = theta->add_loopvar(olv->input()->origin());
+		smap.insert(olv->argument(), nlv->argument());
+		lvs[olv] = nlv;
+	}
+	t1->subregion()->copy(theta->subregion(), smap, false, false);
+
+	/*
+		States passed from the first to the second theta are threaded through both bodies.
+	*/
+	std::unordered_map<jive::output*, jive::theta_output*> threaded;
+	for (const auto & olv : *t2) {
+		auto origin = olv->input()->origin();
+		if (jive::node_output::node(origin) == t1) {
+			auto t1lv = static_cast<jive::theta_output*>(origin);
+			smap.insert(olv->argument(), smap.lookup(t1lv->result()->origin()));
+			threaded[t1lv] = olv;
+			lvs[olv] = lvs[t1lv];
+			continue;
+		}
+
+		auto nlv = theta->add_loopvar(origin);
+		smap.insert(olv->argument(), nlv->argument());
+		lvs[olv] = nlv;
+	}
+	t2->subregion()->copy(theta->subregion(), smap, false, false);
+
+	for (const auto & olv : *t1) {
+		if (threaded.find(olv) != threaded.end())
+			continue;
+
+		lvs[olv]->result()->divert_to(smap.lookup(olv->result()->origin()));
+		olv->divert_users(lvs[olv]);
+	}
+
+	for (const auto & olv : *t2) {
+		lvs[olv]->result()->divert_to(smap.lookup(olv->result()->origin()));
+		olv->divert_users(lvs[olv]);
+	}
+
+	theta->set_predicate(smap.lookup(t1->predicate()->origin()));
+
+	remove(t2);
+	remove(t1);
+}
+
+static bool
+fuse(jive::theta_node * t1, jive::theta_node * t2, size_t & nthetas)
+{
+	if (depends_on(t1, t2))
+		std::swap(t1, t2);
+
+	if (!has_fusable_dependencies(t1, t2))
+		return false;
+
+	auto ui1 = unrollinfo::create(t1);
+	auto ui2 = unrollinfo::create(t2);
+	if (!ui1 || !ui2
+	|| !has_same_range(*ui1, *ui2)
+	|| !has_independent_memory(*ui1, *ui2))
+		return false;
+
+	fuse(t1, t2);
+	nthetas++;
+	return true;
+}
+
+static void
+fuse(jive::region * region, size_t & nthetas)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				fuse(structnode->subregion(n), nthetas);
+		}
+	}
+
+	/*
+		Every fusion removes two thetas from the region. The thetas are therefore collected anew
+		after every fusion.
+	*/
+	bool fused = true;
+	while (fused) {
+		fused = false;
+
+		std::vector<jive::theta_node*> thetas;
+		for (auto & node : region->nodes) {
+			if (auto theta = dynamic_cast<jive::theta_node*>(&node))
+				thetas.push_back(theta);
+		}
+
+		for (size_t i = 0; i < thetas.size() && !fused; i++) {
+			for (size_t j = i+1; j < thetas.size() && !fused; j++)
+				fused = fuse(thetas[i], thetas[j], nthetas);
+		}
+	}
+}
+
+static void
+fuse(rvsdg_module & rm, const stats_descriptor & sd)
+{
+	auto & graph = *rm.graph();
+
+	size_t nthetas = 0;
+	tfsstat stat;
+	stat.start(graph);
+	fuse(graph.root(), nthetas);
+	stat.end(graph, nthetas);
+
+	if (sd.print_thetafusion_stat)
+		sd.print_stat(stat);
+}
+
+/* thetafusion class */
+
+thetafusion::~thetafusion()
+{}
+
+void
+thetafusion::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	fuse(module, sd);
+}
+
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/unswitching.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/substitution.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/rvsdg/traverser.hpp>
+
+#include <unordered_map>
+
+namespace jlm {
+
+class uswstat final : public stat {
+public:
+	virtual
+	~uswstat()
+	{}
+
+	uswstat()
+	: nthetas_(0)
+	, nnodes_before_(0), nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jlm::nnodes(graph);
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t nthetas) noexcept
+	{
+		nthetas_ = nthetas;
+		nnodes_after_ = jlm::nnodes(graph);
+		timer_.stop();
+	}
+
+	virtual std::string
+	to_str() const override
+	{
+		return strfmt("USW ", nnodes_before_, " ", nnodes_after_, " ", nthetas_, " ", timer_.ns());
+	}
+
+private:
+	size_t nthetas_;
+	size_t nnodes_before_, nnodes_after_;
+	jlm::timer timer_;
+};
+
+/*
+	An output of a theta's subregion is loop-invariant if it is an argument of an invariant loop
+	variable, or computed by simple nodes without state from loop-invariant values. The results
+	are memoized in \p invariants, such that shared operands are only visited once.
+*/
+static bool
+is_loop_invariant(
+	jive::output * output,
+	std::unordered_map<const jive::output*, bool> & invariants)
+{
+	auto it = invariants.find(output);
+	if (it != invariants.end())
+		return it->second;
+
+	bool invariant = false;
+	if (auto argument = dynamic_cast<jive::argument*>(output)) {
+		invariant = is_invariant(static_cast<const jive::theta_input*>(argument->input()));
+	} else if (auto node = dynamic_cast<jive::simple_node*>(jive::node_output::node(output))) {
+		invariant = true;
+		for (size_t n = 0; n < node->ninputs() && invariant; n++) {
+			auto input = node->input(n);
+			invariant = !dynamic_cast<const jive::statetype*>(&input->type())
+			         && is_loop_invariant(input->origin(), invariants);
+		}
+	}
+
+	invariants[output] = invariant;
+	return invariant;
+}
+
+/*
+	Copies the computation of the loop-invariant value \p output into the region of the theta.
+*/
+static jive::output *
+hoist(jive::output * output, jive::substitution_map & smap)
+{
+	if (auto substitute = smap.lookup(output))
+		return substitute;
+
+	JLM_ASSERT(!dynamic_cast<jive::argument*>(output));
+	auto node = jive::node_output::node(output);
+
+	std::vector<jive::output*> operands;
+	for (size_t n = 0; n < node->ninputs(); n++)
+		operands.push_back(hoist(node->input(n)->origin(), smap));
+
+	auto theta = output->region()->node();
+	auto copy = node->copy(theta->region(), operands);
+	for (size_t n = 0; n < node->noutputs(); n++)
+		smap.insert(node->output(n), copy->output(n));
+
+	return smap.lookup(output);
+}
+
+static jive::gamma_node *
+find_unswitchable_gamma(const jive::theta_node * theta)
+{
+	std::unordered_map<const jive::output*, bool> invariants;
+	for (auto & node : theta->subregion()->nodes) {
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(&node)) {
+			if (is_loop_invariant(gamma->predicate()->origin(), invariants))
+				return gamma;
+		}
+	}
+
+	return nullptr;
+}
+
+/*
+	Replaces the copy of gamma \p gamma in \p target with the content of its subregion \p n.
+*/
+static void
+inline_alternative(
+	const jive::gamma_node * gamma,
+	size_t n,
+	jive::region * target,
+	jive::substitution_map & smap)
+{
+	jive::substitution_map gmap;
+	for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++)
+		gmap.insert(ev->argument(n), smap.lookup(ev->origin()));
+
+	gamma->subregion(n)->copy(target, gmap, false, false);
+
+	for (size_t i = 0; i < gamma->noutputs(); i++)
+		smap.insert(gamma->output(i), gmap.lookup(gamma->subregion(n)->result(i)->origin()));
+}
+
+/*
+	Copies the body of \p theta into \p target. The nodes are copied in topological order such
+	that \p gamma can be replaced by its subregion \p n.
+*/
+static void
+copy_body(
+	const jive::theta_node * theta,
+	const jive::gamma_node * gamma,
+	size_t n,
+	jive::region * target,
+	jive::substitution_map & smap)
+{
+	for (const auto & node : jive::topdown_traverser(theta->subregion())) {
+		if (node == gamma) {
+			inline_alternative(gamma, n, target, smap);
+			continue;
+		}
+
+		node->copy(target, smap);
+	}
+}
+
+static void
+unswitch(jive::theta_node * theta, jive::gamma_node * gamma)
+{
+	jive::substitution_map smap;
+	for (const auto & lv : *theta)
+		smap.insert(lv->argument(), lv->input()->origin());
+	auto predicate = hoist(gamma->predicate()->origin(), smap);
+
+	auto ngamma = jive::gamma_node::create(predicate, gamma->nsubregions());
+
+	std::vector<jive::gamma_input*> entryvars;
+	for (const auto & lv : *theta)
+		entryvars.push_back(ngamma->add_entryvar(lv->input()->origin()));
+
+	std::vector<std::vector<jive::output*>> exitvars(theta->noutputs());
+	for (size_t n = 0; n < ngamma->nsubregions(); n++) {
+		auto ntheta = jive::theta_node::create(ngamma->subregion(n));
+
+		jive::substitution_map tmap;
+		for (const auto & olv : *theta) {
+			auto nlv = ntheta->add_loopvar(entryvars[olv->index()]->argument(n));
+			tmap.insert(olv->argument(), nlv->argument());
+		}
+
+		copy_body(theta, gamma, n, ntheta->subregion(), tmap);
+
+		for (auto olv = theta->begin(), nlv = ntheta->begin(); olv != theta->end(); olv++, nlv++) {
+			(*nlv)->result()->divert_to(tmap.lookup((*olv)->result()->origin()));
+			exitvars[(*olv)->index()].push_back(*nlv);
+		}
+		ntheta->set_predicate(tmap.lookup(theta->predicate()->origin()));
+	}
+
+	for (const auto & olv : *theta)
+		olv->divert_users(ngamma->add_exitvar(exitvars[olv->index()]));
+
+	remove(theta);
+}
+
+static size_t
+unswitch(jive::region * region, size_t budget)
+{
+	size_t nthetas = 0;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				nthetas += unswitch(structnode->subregion(n), budget);
+		}
+	}
+
+	/*
+		Collect the thetas first, since unswitching removes them from the region. Every theta is
+		unswitched at most once in order to avoid an exponential growth of the code.
+	*/
+	std::vector<std::pair<jive::theta_node*, jive::gamma_node*>> thetas;
+	for (auto & node : region->nodes) {
+		auto theta = dynamic_cast<jive::theta_node*>(&node);
+		if (theta == nullptr)
+			continue;
+
+		auto gamma = find_unswitchable_gamma(theta);
+		if (gamma == nullptr)
+			continue;
+
+		if (jive::nnodes(theta->subregion()) * (gamma->nsubregions()-1) > budget)
+			continue;
+
+		thetas.push_back({theta, gamma});
+	}
+
+	for (const auto & p : thetas)
+		unswitch(p.first, p.second);
+
+	return nthetas + thetas.size();
+}
+
+static void
+unswitch(rvsdg_module & rm, const stats_descriptor & sd, size_t budget)
+{
+	auto & graph = *rm.graph();
+
+	uswstat stat;
+	stat.start(graph);
+	auto nthetas = unswitch(graph.root(), budget);
+	stat.end(graph, nthetas);
+
+	if (sd.print_unswitching_stat)
+		sd.print_stat(stat);
+}
+
+/* loopunswitching class */
+
+loopunswitching::~loopunswitching()
+{}
+
+void
+loopunswitching::run(rvsdg_module & module, const stats_descriptor & sd)
+{
+	unswitch(module, sd, budget_);
+}
+
+}
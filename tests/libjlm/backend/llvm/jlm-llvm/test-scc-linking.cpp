@@ -0,0 +1,101 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.hpp"
+#include "test-util.hpp"
+
+#include <jive/rvsdg/graph.hpp>
+
+#include <jlm/backend/llvm/jlm2llvm/jlm2llvm.hpp>
+#include <jlm/backend/llvm/rvsdg2jlm/rvsdg2jlm.hpp>
+#include <jlm/frontend/llvm/jlm2rvsdg/module.hpp>
+#include <jlm/frontend/llvm/llvm2jlm/module.hpp>
+#include <jlm/ir/ipgraph.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/util/stats.hpp>
+
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+
+/*
+	Creates a module with an internal function f and an external function g that calls f. Both
+	functions end up in SCCs of their own.
+*/
+static std::unique_ptr<llvm::Module>
+setup(llvm::LLVMContext & ctx)
+{
+	using namespace llvm;
+
+	std::unique_ptr<Module> module(new Module("module", ctx));
+
+	auto int32 = Type::getInt32Ty(ctx);
+	auto ft = FunctionType::get(int32, {int32}, false);
+
+	auto f = Function::Create(ft, GlobalValue::InternalLinkage, "f", module.get());
+	IRBuilder<> fbuilder(BasicBlock::Create(ctx, "bb", f));
+	fbuilder.CreateRet(fbuilder.CreateAdd(&*f->arg_begin(), ConstantInt::get(int32, 1)));
+
+	auto g = Function::Create(ft, GlobalValue::ExternalLinkage, "g", module.get());
+	IRBuilder<> gbuilder(BasicBlock::Create(ctx, "bb", g));
+	gbuilder.CreateRet(gbuilder.CreateCall(f, {&*g->arg_begin()}));
+
+	return module;
+}
+
+static int
+test()
+{
+	using namespace jlm;
+
+	llvm::LLVMContext ctx;
+	auto lm = setup(ctx);
+	auto im = convert_module(*lm);
+
+	stats_descriptor sd;
+	auto output = std::make_unique<llvm::Module>("output", ctx);
+	const ipgraph & ipg = im->ipgraph();
+	for (const auto & scc : ipg.find_sccs()) {
+		assert(scc.size() == 1);
+		auto name = (*scc.begin())->name();
+
+		/*
+			Every node of the SCC is exported, while f is imported into the module of g.
+		*/
+		auto rm = construct_rvsdg(*im, scc, sd);
+		auto root = rm->graph()->root();
+		assert(root->nresults() == 1);
+		assert(root->narguments() == (name == "g" ? 1 : 0));
+
+		auto jm = rvsdg2jlm::rvsdg2jlm(*rm, sd);
+		jlm::jlm2llvm::link(*output, jlm::jlm2llvm::convert(*jm, ctx));
+	}
+	jlm::print(*output);
+
+	/*
+		The call in g resolves to the definition of f, which keeps its internal linkage.
+	*/
+	auto f = output->getFunction("f");
+	auto g = output->getFunction("g");
+	assert(f && !f->isDeclaration() && f->hasInternalLinkage());
+	assert(g && !g->isDeclaration());
+
+	size_t ncalls = 0;
+	for (auto & bb : *g) {
+		for (auto & instruction : bb) {
+			if (auto call = llvm::dyn_cast<llvm::CallInst>(&instruction)) {
+				assert(call->getCalledFunction() == f);
+				ncalls++;
+			}
+		}
+	}
+	assert(ncalls == 1);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/backend/llvm/jlm-llvm/test-scc-linking", test)
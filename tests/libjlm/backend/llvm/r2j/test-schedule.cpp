@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/rvsdg/graph.hpp>
+#include <jive/types/bitstring/arithmetic.hpp>
+
+#include <jlm/backend/llvm/rvsdg2jlm/schedule.hpp>
+
+#include <algorithm>
+
+static bool
+is_valid(const std::vector<jive::node*> & schedule, const jive::region & region)
+{
+	if (schedule.size() != region.nnodes())
+		return false;
+
+	for (size_t n = 0; n < schedule.size(); n++) {
+		auto node = schedule[n];
+		for (size_t i = 0; i < node->ninputs(); i++) {
+			auto producer = jive::node_output::node(node->input(i)->origin());
+			if (producer == nullptr)
+				continue;
+
+			auto it = std::find(schedule.begin(), schedule.end(), producer);
+			if (it == schedule.end() || it - schedule.begin() > (ptrdiff_t)n)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static void
+test_pressure()
+{
+	using namespace jlm;
+	using namespace jlm::rvsdg2jlm;
+
+	valuetype vt;
+
+	jive::graph graph;
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto a = create_testop(graph.root(), {x}, {&vt})[0];
+	auto c = create_testop(graph.root(), {y}, {&vt})[0];
+	auto b = create_testop(graph.root(), {a}, {&vt})[0];
+	auto d = create_testop(graph.root(), {b, c}, {&vt})[0];
+
+	graph.add_export(d, {vt, "d"});
+
+	for (auto mode : {schedulingmode::topdown, schedulingmode::pressure, schedulingmode::latency})
+		assert(is_valid(schedule(*graph.root(), mode), *graph.root()));
+
+	/* c is placed right before its use */
+	auto s = schedule(*graph.root(), schedulingmode::pressure);
+	assert(s[2] == jive::node_output::node(c));
+	assert(s[3] == jive::node_output::node(d));
+}
+
+static void
+test_latency()
+{
+	using namespace jlm;
+	using namespace jlm::rvsdg2jlm;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto x = graph.add_import({bt32, "x"});
+	auto y = graph.add_import({bt32, "y"});
+
+	auto add = jive::bitadd_op::create(32, x, y);
+	auto mul = jive::bitmul_op::create(32, add, y);
+	auto div = jive::bitsdiv_op::create(32, x, y);
+
+	graph.add_export(mul, {bt32, "mul"});
+	graph.add_export(div, {bt32, "div"});
+
+	auto s = schedule(*graph.root(), schedulingmode::latency);
+	assert(is_valid(s, *graph.root()));
+
+	/* the division has the longest latency and is started first */
+	assert(s[0] == jive::node_output::node(div));
+	assert(s[1] == jive::node_output::node(add));
+	assert(s[2] == jive::node_output::node(mul));
+
+	/* the estimates are memoized per node */
+	latencymap latencies;
+	assert(latencies.latency(*jive::node_output::node(div)) == 20);
+	assert(latencies.latency(*jive::node_output::node(mul)) == 3);
+	assert(latencies.latency(*jive::node_output::node(add)) == 1);
+	assert(latencies.latency(*jive::node_output::node(div)) == 20);
+}
+
+static int
+test()
+{
+	test_pressure();
+	test_latency();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/backend/llvm/r2j/test-schedule", test)
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/frontend/llvm/llvm2jlm/module.hpp>
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/util/parallel.hpp>
+
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+
+#include <assert.h>
+#include <map>
+#include <set>
+
+/*
+	Creates a module with many functions. Every function reads and writes two shared globals, and
+	calls the function created before it.
+*/
+static std::unique_ptr<llvm::Module>
+setup(llvm::LLVMContext & ctx)
+{
+	using namespace llvm;
+
+	std::unique_ptr<Module> module(new Module("module", ctx));
+
+	auto int64 = Type::getInt64Ty(ctx);
+	auto g1 = new GlobalVariable(*module, int64, false, GlobalValue::InternalLinkage,
+		ConstantInt::get(int64, 1), "g1");
+	auto g2 = new GlobalVariable(*module, int64, false, GlobalValue::ExternalLinkage,
+		ConstantInt::get(int64, 2), "g2");
+
+	auto ftype = FunctionType::get(int64, {int64}, false);
+	Function * previous = nullptr;
+	for (size_t n = 0; n < 64; n++) {
+		auto linkage = n == 63 ? GlobalValue::ExternalLinkage : GlobalValue::InternalLinkage;
+		auto f = Function::Create(ftype, linkage, "f" + std::to_string(n), module.get());
+
+		auto entry = BasicBlock::Create(ctx, "entry", f);
+		auto then = BasicBlock::Create(ctx, "then", f);
+		auto exit = BasicBlock::Create(ctx, "exit", f);
+
+		IRBuilder<> builder(entry);
+		auto v1 = builder.CreateLoad(int64, g1);
+		auto sum = builder.CreateAdd(v1, f->getArg(0));
+		auto cmp = builder.CreateICmpSGT(sum, ConstantInt::get(int64, n));
+		builder.CreateCondBr(cmp, then, exit);
+
+		builder.SetInsertPoint(then);
+		auto v2 = previous ? builder.CreateCall(previous, {sum}) : sum;
+		builder.CreateStore(v2, g2);
+		builder.CreateBr(exit);
+
+		builder.SetInsertPoint(exit);
+		auto phi = builder.CreatePHI(int64, 2);
+		phi->addIncoming(sum, entry);
+		phi->addIncoming(v2, then);
+		builder.CreateStore(phi, g1);
+		builder.CreateRet(phi);
+
+		previous = f;
+	}
+
+	return module;
+}
+
+/*
+	Summarizes the converted functions of \p im by their number of basic blocks and the
+	operations of their tacs. Variable names are omitted, as they depend on the order in which
+	the tacs are created.
+*/
+static std::map<std::string, std::multiset<std::string>>
+summarize(const jlm::ipgraph_module & im)
+{
+	std::map<std::string, std::multiset<std::string>> summary;
+	for (const auto & node : im.ipgraph()) {
+		auto fn = dynamic_cast<const jlm::function_node*>(&node);
+		if (fn == nullptr || fn->cfg() == nullptr)
+			continue;
+
+		auto & operations = summary[fn->name()];
+		operations.insert(std::to_string(fn->cfg()->nnodes()));
+		for (const auto & bb : *fn->cfg()) {
+			for (const auto & tac : bb)
+				operations.insert(tac->operation().debug_string());
+		}
+	}
+
+	return summary;
+}
+
+static int
+test()
+{
+	llvm::LLVMContext ctx;
+	auto module = setup(ctx);
+
+	auto limit = jlm::maxthreads().load();
+
+	jlm::maxthreads() = 1;
+	auto serial = summarize(*jlm::convert_module(*module));
+
+	/* force the parallel path independent of the number of hardware threads */
+	jlm::maxthreads() = 8;
+	auto parallel = summarize(*jlm::convert_module(*module));
+
+	jlm::maxthreads() = limit;
+
+	assert(serial.size() == 64);
+	assert(serial == parallel);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/frontend/llvm/llvm-jlm/test-parallel-conversion", test)
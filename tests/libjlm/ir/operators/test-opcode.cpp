@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <jlm/ir/operators.hpp>
+
+static void
+test_opcodes()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ptrtype pt(vt);
+
+	load_op load(pt, 1, 4);
+	assert(load.code() == opcode::load_op);
+	assert(get_opcode(load) == opcode::load_op);
+
+	/* the opcode is copied with the operation */
+	auto copy = load.copy();
+	assert(get_opcode(*copy) == opcode::load_op);
+
+	assert(get_opcode(jive::bitadd_op(32)) == opcode::bitadd_op);
+
+	test_op op({&vt}, {&vt});
+	assert(get_opcode(op) == opcode::other);
+}
+
+static void
+test_hash()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ptrtype pt(vt);
+
+	load_op load1(pt, 1, 4);
+	load_op load2(pt, 1, 4);
+	assert(hash(load1) == hash(load2));
+
+	/* operations of the same class with different parameters hash differently */
+	assert(hash(jive::bitadd_op(32)) != hash(jive::bitadd_op(64)));
+	assert(hash(load1) != hash(load_op(ptrtype(jive::bit32), 1, 4)));
+	assert(hash(load1) != hash(load_op(pt, 1, 8)));
+	assert(hash(jive::bitconstant_op(jive::bitvalue_repr(32, 1)))
+		!= hash(jive::bitconstant_op(jive::bitvalue_repr(32, 2))));
+
+	test_op op1({&vt}, {&vt});
+	test_op op2({&vt}, {&vt});
+	assert(hash(op1) == hash(op2));
+}
+
+static int
+test()
+{
+	test_opcodes();
+	test_hash();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/operators/test-opcode", test)
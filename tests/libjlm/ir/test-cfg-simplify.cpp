@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/cfg-structure.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/print.hpp>
+
+static inline void
+test_simplify()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({}, {&vt});
+
+	/* setup cfg */
+
+	ipgraph_module im(filepath(""), "", "");
+
+	jlm::cfg cfg(im);
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+
+	bb0->append_last(tac::create(op, {}));
+	bb2->append_last(tac::create(op, {}));
+	bb3->append_last(tac::create(op, {}));
+
+	cfg.exit()->divert_inedges(bb0);
+	bb0->add_outedge(bb1);
+	bb1->add_outedge(bb2);
+	bb2->add_outedge(cfg.exit());
+	bb3->add_outedge(bb2);
+	cfg.exit()->append_result(bb2->last()->result(0));
+
+	print_ascii(cfg, stdout);
+
+	/* verify simplification */
+
+	simplify(cfg, true);
+	print_ascii(cfg, stdout);
+
+	assert(cfg.nnodes() == 1);
+	auto bb = static_cast<const basic_block*>(cfg.entry()->outedge(0)->sink());
+	assert(bb->ntacs() == 2);
+	assert(bb->outedge(0)->sink() == cfg.exit());
+}
+
+static inline void
+test_phi()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({}, {&vt});
+
+	ipgraph_module im(filepath(""), "", "");
+
+	jlm::cfg cfg(im);
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+
+	bb0->append_last(tac::create(op, {}));
+	bb3->append_last(tac::create(op, {}));
+	bb2->append_last(phi_op::create({{bb0->last()->result(0), bb1},
+		{bb3->last()->result(0), bb3}}, vt));
+
+	cfg.exit()->divert_inedges(bb0);
+	bb0->add_outedge(bb1);
+	bb1->add_outedge(bb2);
+	bb2->add_outedge(cfg.exit());
+	bb3->add_outedge(bb2);
+	cfg.exit()->append_result(bb2->last()->result(0));
+
+	print_ascii(cfg, stdout);
+
+	simplify(cfg, true);
+	print_ascii(cfg, stdout);
+
+	/*
+		After pruning bb3, the phi of bb2 has a single operand from bb1. Neither bb1 nor bb0 are
+		merged into bb2.
+	*/
+	assert(is_valid(cfg));
+	assert(cfg.nnodes() == 2);
+	assert(bb2->ninedges() == 1);
+	assert(is<phi_op>(bb2->first()));
+	assert(static_cast<const phi_op*>(&bb2->first()->operation())->node(0) == bb1);
+}
+
+static int
+test()
+{
+	test_simplify();
+	test_phi();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-cfg-simplify", test)
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jive/rvsdg/control.hpp>
+
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/cfg-structure.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/print.hpp>
+
+static inline void
+test_predicate_block()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+	test_op op({&vt}, {&vt});
+
+	ipgraph_module im(filepath(""), "", "");
+
+	jlm::cfg cfg(im);
+	auto c = cfg.entry()->append_argument(argument::create("c", ct));
+	auto x = cfg.entry()->append_argument(argument::create("x", vt));
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+	auto bb4 = basic_block::create(cfg);
+	auto bb5 = basic_block::create(cfg);
+	auto bb6 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb0);
+	bb0->add_outedge(bb1);
+	bb0->add_outedge(bb2);
+	bb1->add_outedge(bb3);
+	bb2->add_outedge(bb3);
+	bb3->add_outedge(bb4);
+	bb3->add_outedge(bb5);
+	bb4->add_outedge(bb6);
+	bb5->add_outedge(bb6);
+	bb6->add_outedge(cfg.exit());
+
+	bb0->append_last(branch_op::create(2, c));
+	bb1->append_last(tac::create(jive::ctlconstant_op(jive::ctlvalue_repr(1, 2)), {}));
+	bb2->append_last(tac::create(jive::ctlconstant_op(jive::ctlvalue_repr(0, 2)), {}));
+	bb3->append_last(phi_op::create({{bb1->last()->result(0), bb1}, {bb2->last()->result(0), bb2}}, ct));
+	bb3->append_last(branch_op::create(2, bb3->last()->result(0)));
+	bb4->append_last(tac::create(op, {x}));
+	bb5->append_last(tac::create(op, {x}));
+	bb6->append_last(phi_op::create({{bb4->last()->result(0), bb4}, {bb5->last()->result(0), bb5}}, vt));
+	cfg.exit()->append_result(bb6->last()->result(0));
+
+	print_ascii(cfg, stdout);
+
+	thread_branches(cfg);
+	print_ascii(cfg, stdout);
+
+	/*
+		bb1 and bb2 are merged with bb5 and bb4, respectively, and bb3 is removed.
+	*/
+	assert(is_valid(cfg));
+	assert(cfg.nnodes() == 4);
+
+	size_t nbranches = 0;
+	for (auto & node : cfg) {
+		if (is<branch_op>(static_cast<basic_block*>(&node)->last()))
+			nbranches++;
+	}
+	assert(nbranches == 1);
+}
+
+static inline void
+test_constant_branch()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({&vt}, {&vt});
+
+	ipgraph_module im(filepath(""), "", "");
+
+	jlm::cfg cfg(im);
+	auto x = cfg.entry()->append_argument(argument::create("x", vt));
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb0);
+	bb0->add_outedge(bb1);
+	bb0->add_outedge(bb2);
+	bb1->add_outedge(bb2);
+	bb2->add_outedge(cfg.exit());
+
+	bb0->append_last(tac::create(jive::ctlconstant_op(jive::ctlvalue_repr(1, 2)), {}));
+	bb0->append_last(branch_op::create(2, bb0->last()->result(0)));
+	bb1->append_last(tac::create(op, {x}));
+	bb2->append_last(phi_op::create({{x, bb0}, {bb1->last()->result(0), bb1}}, vt));
+	cfg.exit()->append_result(bb2->last()->result(0));
+
+	print_ascii(cfg, stdout);
+
+	thread_branches(cfg);
+	print_ascii(cfg, stdout);
+
+	/*
+		bb0 is merged with bb1, while bb2 is kept as it starts with a phi.
+	*/
+	assert(is_valid(cfg));
+	assert(cfg.nnodes() == 2);
+	assert(bb2->ninedges() == 1);
+}
+
+static int
+test()
+{
+	test_predicate_block();
+	test_constant_branch();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-cfg-thread", test)
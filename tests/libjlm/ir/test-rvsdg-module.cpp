@@ -0,0 +1,104 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+
+static inline void
+test_nnodes()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+	assert(jlm::nnodes(graph) == 0);
+
+	auto x = graph.add_import({vt, "x"});
+	auto n1 = create_testop(graph.root(), {x}, {&vt})[0];
+
+	auto lambda = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+	auto n2 = create_testop(lambda->subregion(), {lambda->fctargument(0)}, {&vt})[0];
+	auto n3 = create_testop(lambda->subregion(), {n2}, {&vt})[0];
+	lambda->finalize({n3});
+
+	graph.add_export(n1, {vt, "n1"});
+	assert(jlm::nnodes(graph) == 4);
+	assert(jlm::nnodes(graph) == jive::nnodes(graph.root()));
+
+	graph.prune();
+	assert(jlm::nnodes(graph) == 1);
+	assert(rm.nnodes() == 1);
+	assert(jlm::nnodes(graph) == jive::nnodes(graph.root()));
+}
+
+static inline void
+test_nnodes_unowned()
+{
+	using namespace jlm;
+
+	valuetype vt;
+
+	/* graphs that do not belong to a module are counted by traversal */
+	jive::graph graph;
+	auto x = graph.add_import({vt, "x"});
+	auto n1 = create_testop(graph.root(), {x}, {&vt})[0];
+	create_testop(graph.root(), {n1}, {&vt});
+
+	assert(jlm::nnodes(graph) == 2);
+}
+
+static inline void
+test_touched_nodes()
+{
+	using namespace jlm;
+
+	valuetype vt;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+	auto n1 = create_testop(graph.root(), {x}, {&vt})[0];
+	assert(rm.pop_touched_node() == nullptr);
+
+	rm.record_touched_nodes();
+	auto n2 = create_testop(graph.root(), {x}, {&vt})[0];
+	auto n3 = create_testop(graph.root(), {x}, {&vt})[0];
+	jive::node_output::node(n1)->input(0)->divert_to(y);
+	jive::node_output::node(n2)->input(0)->divert_to(y);
+
+	/* nodes are returned once and in the order they were first touched */
+	assert(rm.pop_touched_node() == jive::node_output::node(n2));
+	assert(rm.pop_touched_node() == jive::node_output::node(n3));
+	assert(rm.pop_touched_node() == jive::node_output::node(n1));
+	assert(rm.pop_touched_node() == nullptr);
+
+	/* removed nodes are forgotten */
+	jive::node_output::node(n3)->input(0)->divert_to(y);
+	jive::remove(jive::node_output::node(n3));
+	assert(rm.pop_touched_node() == nullptr);
+}
+
+static int
+verify()
+{
+	test_nnodes();
+	test_nnodes_unowned();
+	test_touched_nodes();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-rvsdg-module", verify)
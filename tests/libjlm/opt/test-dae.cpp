@@ -0,0 +1,131 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/phi.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/dae.hpp>
+#include <jlm/opt/dne.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static const jlm::lambda::node *
+find_lambda(const jive::region * region, const std::string & name)
+{
+	for (const auto & node : region->nodes) {
+		if (auto lambda = dynamic_cast<const jlm::lambda::node*>(&node)) {
+			if (lambda->name() == name)
+				return lambda;
+		}
+
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++) {
+				if (auto lambda = find_lambda(structnode->subregion(n), name))
+					return lambda;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+static inline void
+test_lambda()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft1({&vt, &vt}, {&vt, &vt});
+	jive::fcttype ft2({&vt, &vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	/* f */
+	auto f = lambda::node::create(graph.root(), ft1, "f", linkage::internal_linkage);
+	auto t = create_testop(f->subregion(), {f->fctargument(0)}, {&vt})[0];
+	f->finalize({t, t});
+
+	/* g */
+	auto g = lambda::node::create(graph.root(), ft2, "g", linkage::external_linkage);
+	auto cv = g->add_ctxvar(f->output());
+	auto call = call_op::create(cv, {g->fctargument(0), g->fctargument(1)});
+	g->finalize({call[0]});
+
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::dae dae;
+	dae.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto lambda = find_lambda(graph.root(), "f");
+	assert(lambda->nfctarguments() == 1);
+	assert(lambda->nfctresults() == 1);
+}
+
+static inline void
+test_phi()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft({&vt, &vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	jive::phi::builder pb;
+	pb.begin(graph.root());
+	auto rv = pb.add_recvar(ptrtype(ft));
+
+	/* f calls itself, but never uses its second argument */
+	auto f = lambda::node::create(pb.subregion(), ft, "f", linkage::internal_linkage);
+	auto cv = f->add_ctxvar(rv->argument());
+	auto call = call_op::create(cv, {f->fctargument(0), f->fctargument(0)});
+	auto t = create_testop(f->subregion(), {call[0]}, {&vt})[0];
+	rv->set_rvorigin(f->finalize({t}));
+	auto phi = pb.end();
+
+	/* g */
+	auto g = lambda::node::create(graph.root(), ft, "g", linkage::external_linkage);
+	auto cvf = g->add_ctxvar(phi->output(0));
+	auto call2 = call_op::create(cvf, {g->fctargument(0), g->fctargument(1)});
+	g->finalize({call2[0]});
+
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::dae dae;
+	dae.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto lambda = find_lambda(graph.root(), "f");
+	assert(lambda->nfctarguments() == 1);
+	assert(lambda->nfctresults() == 1);
+	assert(!find_lambda(graph.root(), "g")->fctargument(1)->nusers());
+}
+
+static int
+verify()
+{
+	test_lambda();
+	test_phi();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-dae", verify)
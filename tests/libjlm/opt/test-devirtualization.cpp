@@ -0,0 +1,147 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/gamma.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/devirtualization.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static bool
+has_indirect_calls(jive::region * region)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++) {
+				if (has_indirect_calls(structnode->subregion(n)))
+					return true;
+			}
+			continue;
+		}
+
+		auto simple = static_cast<jive::simple_node*>(&node);
+		if (jlm::is<jlm::call_op>(simple) && !jlm::is_direct_call(*simple))
+			return true;
+	}
+
+	return false;
+}
+
+static jlm::lambda::node *
+create_function(jive::region * region, const jive::fcttype & type, const std::string & name)
+{
+	using namespace jlm;
+
+	valuetype vt;
+	auto lambda = lambda::node::create(region, type, name, linkage::internal_linkage);
+	auto t = create_testop(lambda->subregion(), {lambda->fctargument(0)}, {&vt})[0];
+	lambda->finalize({t});
+
+	return lambda;
+}
+
+static inline void
+test_gamma()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+	jive::fcttype ft1({&vt}, {&vt});
+	jive::fcttype ft2({&ct, &vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f1 = create_function(graph.root(), ft1, "f1");
+	auto f2 = create_function(graph.root(), ft1, "f2");
+
+	auto g = lambda::node::create(graph.root(), ft2, "g", linkage::external_linkage);
+	auto cv1 = g->add_ctxvar(f1->output());
+	auto cv2 = g->add_ctxvar(f2->output());
+
+	auto gamma = jive::gamma_node::create(g->fctargument(0), 2);
+	auto ev1 = gamma->add_entryvar(cv1);
+	auto ev2 = gamma->add_entryvar(cv2);
+	auto fct = gamma->add_exitvar({ev1->argument(0), ev2->argument(1)});
+
+	auto call = call_op::create(fct, {g->fctargument(1)});
+	g->finalize(call);
+
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+	assert(has_indirect_calls(graph.root()));
+
+//	jive::view(graph.root(), stdout);
+	jlm::devirtualization devirtualization(4);
+	devirtualization.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(!has_indirect_calls(graph.root()));
+}
+
+static inline void
+test_select()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft1({&vt}, {&vt});
+	jive::fcttype ft2({&jive::bit1, &vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f1 = create_function(graph.root(), ft1, "f1");
+	auto f2 = create_function(graph.root(), ft1, "f2");
+	auto f3 = create_function(graph.root(), ft1, "f3");
+
+	auto g = lambda::node::create(graph.root(), ft2, "g", linkage::external_linkage);
+	auto cv1 = g->add_ctxvar(f1->output());
+	auto cv2 = g->add_ctxvar(f2->output());
+	auto cv3 = g->add_ctxvar(f3->output());
+
+	select_op op(ptrtype(ft1));
+	auto s1 = jive::simple_node::create_normalized(g->subregion(), op, {g->fctargument(0), cv1, cv2})[0];
+	auto s2 = jive::simple_node::create_normalized(g->subregion(), op, {g->fctargument(0), s1, cv3})[0];
+
+	auto call = call_op::create(s2, {g->fctargument(1)});
+	g->finalize(call);
+
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::devirtualization devirtualization(2);
+	devirtualization.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	/* three targets exceed the limit of two */
+	assert(has_indirect_calls(graph.root()));
+
+	jlm::devirtualization devirtualization3(3);
+	devirtualization3.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(!has_indirect_calls(graph.root()));
+}
+
+static int
+verify()
+{
+	test_gamma();
+	test_select();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-devirtualization", verify)
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/functionmerging.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static jlm::lambda::output *
+create_lambda(
+	jive::region * region,
+	const std::string & name,
+	const jlm::linkage & linkage)
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	auto lambda = lambda::node::create(region, ft, name, linkage);
+	auto t = create_testop(lambda->subregion(), {lambda->fctargument(0)}, {&vt})[0];
+	return lambda->finalize({t});
+}
+
+static inline void
+test_internal()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f1 = create_lambda(graph.root(), "f1", linkage::internal_linkage);
+	auto f2 = create_lambda(graph.root(), "f2", linkage::internal_linkage);
+
+	auto g = lambda::node::create(graph.root(), ft, "g", linkage::external_linkage);
+	auto cv1 = g->add_ctxvar(f1);
+	auto cv2 = g->add_ctxvar(f2);
+	auto call1 = call_op::create(cv1, {g->fctargument(0)});
+	auto call2 = call_op::create(cv2, {call1[0]});
+	g->finalize({call2[0]});
+
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::functionmerging functionmerging;
+	functionmerging.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(graph.root()->nnodes() == 2);
+	assert(g->input(0)->origin() == g->input(1)->origin());
+}
+
+static inline void
+test_exported()
+{
+	using namespace jlm;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f1 = create_lambda(graph.root(), "f1", linkage::external_linkage);
+	auto f2 = create_lambda(graph.root(), "f2", linkage::external_linkage);
+
+	auto x1 = graph.add_export(f1, {f1->type(), "f1"});
+	auto x2 = graph.add_export(f2, {f2->type(), "f2"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::functionmerging functionmerging;
+	functionmerging.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(x1->origin() == f1);
+
+	auto forwarder = static_cast<const lambda::node*>(jive::node_output::node(x2->origin()));
+	assert(forwarder->name() == "f2");
+	assert(forwarder->input(0)->origin() == f1);
+	assert(jive::is<call_op>(jive::node_output::node(forwarder->fctresult(0)->origin())));
+}
+
+static inline void
+test_one_to_one()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft({&vt}, {&vt, &vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	/* f1 returns two nodes, while f2 returns the same node twice */
+	auto f1 = lambda::node::create(graph.root(), ft, "f1", linkage::external_linkage);
+	auto t1 = create_testop(f1->subregion(), {f1->fctargument(0)}, {&vt})[0];
+	auto t2 = create_testop(f1->subregion(), {f1->fctargument(0)}, {&vt})[0];
+	auto o1 = f1->finalize({t1, t2});
+
+	auto f2 = lambda::node::create(graph.root(), ft, "f2", linkage::external_linkage);
+	auto u1 = create_testop(f2->subregion(), {f2->fctargument(0)}, {&vt})[0];
+	create_testop(f2->subregion(), {f2->fctargument(0)}, {&vt});
+	auto o2 = f2->finalize({u1, u1});
+
+	auto x1 = graph.add_export(o1, {o1->type(), "f1"});
+	auto x2 = graph.add_export(o2, {o2->type(), "f2"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::functionmerging functionmerging;
+	functionmerging.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(x1->origin() == o1);
+	assert(x2->origin() == o2);
+}
+
+static int
+verify()
+{
+	test_internal();
+	test_exported();
+	test_one_to_one();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-functionmerging", verify)
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/dne.hpp>
+#include <jlm/opt/gammafusion.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static size_t
+ngammas(const jive::region * region)
+{
+	size_t ngammas = 0;
+	for (const auto & node : region->nodes) {
+		if (jive::is<jive::gamma_op>(&node))
+			ngammas++;
+	}
+
+	return ngammas;
+}
+
+static inline void
+test_fusion()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({ct, "c"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto gamma1 = jive::gamma_node::create(c, 2);
+	auto ev1 = gamma1->add_entryvar(x);
+	auto t0 = create_testop(gamma1->subregion(0), {ev1->argument(0)}, {&vt})[0];
+	auto xv1 = gamma1->add_exitvar({t0, ev1->argument(1)});
+
+	auto gamma2 = jive::gamma_node::create(c, 2);
+	auto ev2 = gamma2->add_entryvar(xv1);
+	auto t1 = create_testop(gamma2->subregion(1), {ev2->argument(1)}, {&vt})[0];
+	auto xv2 = gamma2->add_exitvar({ev2->argument(0), t1});
+
+	graph.add_export(xv2, {vt, "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::gammafusion gammafusion;
+	gammafusion.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(ngammas(graph.root()) == 1);
+}
+
+static inline void
+test_threading()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({ct, "c"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto gamma1 = jive::gamma_node::create(c, 2);
+	auto c0 = jive_control_constant(gamma1->subregion(0), 2, 1);
+	auto c1 = jive_control_constant(gamma1->subregion(1), 2, 0);
+	auto xv1 = gamma1->add_exitvar({c0, c1});
+
+	auto gamma2 = jive::gamma_node::create(xv1, 2);
+	auto ev2 = gamma2->add_entryvar(x);
+	auto t0 = create_testop(gamma2->subregion(0), {ev2->argument(0)}, {&vt})[0];
+	auto t1 = create_testop(gamma2->subregion(1), {ev2->argument(1)}, {&vt})[0];
+	auto xv2 = gamma2->add_exitvar({t0, t1});
+
+	graph.add_export(xv2, {vt, "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::gammafusion gammafusion;
+	gammafusion.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(ngammas(graph.root()) == 1);
+	assert(jive::node_output::node(graph.root()->result(0)->origin()) == gamma1);
+}
+
+static int
+verify()
+{
+	test_fusion();
+	test_threading();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-gammafusion", verify)
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/globalfolding.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static jlm::delta::output *
+create_array(jive::region * region, const std::string & name)
+{
+	using namespace jlm;
+
+	arraytype at(jive::bit32, 2);
+	auto delta = delta::node::create(region, ptrtype(at), name, linkage::internal_linkage, false);
+
+	auto c0 = jive::create_bitconstant(delta->subregion(), 32, 5);
+	auto c1 = jive::create_bitconstant(delta->subregion(), 32, 7);
+	ConstantDataArray op(jive::bit32, 2);
+	auto array = jive::simple_node::create_normalized(delta->subregion(), op, {c0, c1})[0];
+
+	return delta->finalize(array);
+}
+
+static inline void
+test_fold()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	ptrtype pt(jive::bit32);
+	jive::fcttype ft({&mt}, {&jive::bit32, &mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto d = create_array(graph.root(), "d");
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+	auto cv = f->add_ctxvar(d);
+
+	auto zero = jive::create_bitconstant(f->subregion(), 64, 0);
+	auto one = jive::create_bitconstant(f->subregion(), 64, 1);
+	auto gep = getelementptr_op::create(cv, {zero, one}, pt);
+	auto load = load_op::create(gep, {f->fctargument(0)}, 4);
+
+	f->finalize({load[0], load[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::globalfolding globalfolding;
+	globalfolding.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto delta = static_cast<delta::node*>(jive::node_output::node(f->input(0)->origin()));
+	assert(delta->constant());
+
+	auto constant = jive::node_output::node(f->fctresult(0)->origin());
+	assert(is<jive::bitconstant_op>(constant));
+	auto & value = static_cast<const jive::bitconstant_op*>(&constant->operation())->value();
+	assert(value.to_uint() == 7);
+	assert(f->fctresult(1)->origin() == f->fctargument(0));
+}
+
+static inline void
+test_store()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	ptrtype pt(jive::bit32);
+	jive::fcttype ft({&mt}, {&jive::bit32, &mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto d = create_array(graph.root(), "d");
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+	auto cv = f->add_ctxvar(d);
+
+	auto zero = jive::create_bitconstant(f->subregion(), 64, 0);
+	auto one = jive::create_bitconstant(f->subregion(), 64, 1);
+	auto three = jive::create_bitconstant(f->subregion(), 32, 3);
+	auto gep0 = getelementptr_op::create(cv, {zero, zero}, pt);
+	auto gep1 = getelementptr_op::create(cv, {zero, one}, pt);
+	auto store = store_op::create(gep0, three, {f->fctargument(0)}, 4);
+	auto load = load_op::create(gep1, store, 4);
+
+	f->finalize({load[0], load[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::globalfolding globalfolding;
+	globalfolding.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto delta = static_cast<delta::node*>(jive::node_output::node(f->input(0)->origin()));
+	assert(!delta->constant());
+	assert(is<load_op>(jive::node_output::node(f->fctresult(0)->origin())));
+}
+
+static int
+verify()
+{
+	test_fold();
+	test_store();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-globalfolding", verify)
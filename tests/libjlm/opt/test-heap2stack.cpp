@@ -0,0 +1,106 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/dne.hpp>
+#include <jlm/opt/heap2stack.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static jlm::lambda::node *
+create_lambda(jive::graph & graph, size_t size, bool escape)
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	iostatetype iot;
+	ptrtype pt(jive::bit8);
+	jive::fcttype ft({&jive::bit8, &mt, &iot}, {&jive::bit8, &pt, &mt, &iot});
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto s = jive::create_bitconstant(f->subregion(), 64, size);
+	auto m = malloc_op::create(s);
+	auto mux = memstatemux_op::create_merge({m[1], f->fctargument(1)});
+
+	auto st = store_op::create(m[0], f->fctargument(0), {mux}, 1);
+	auto ld = load_op::create(m[0], st, 1);
+	auto fr = free_op::create(m[0], {ld[1]}, f->fctargument(2));
+
+	auto null = ptr_constant_null_op::create(f->subregion(), pt);
+	f->finalize({ld[0], escape ? m[0] : null, fr[0], fr[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+	return f;
+}
+
+static inline void
+test_promotion()
+{
+	using namespace jlm;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto f = create_lambda(*rm.graph(), 8, false);
+
+//	jive::view(rm.graph()->root(), stdout);
+	jlm::heap2stack heap2stack(1024);
+	heap2stack.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(rm.graph()->root(), stdout);
+
+	assert(!jive::contains<malloc_op>(f->subregion(), true));
+	assert(!jive::contains<free_op>(f->subregion(), true));
+	assert(jive::contains<alloca_op>(f->subregion(), true));
+}
+
+static inline void
+test_escape()
+{
+	using namespace jlm;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto f = create_lambda(*rm.graph(), 8, true);
+
+	jlm::heap2stack heap2stack(1024);
+	heap2stack.run(rm, sd);
+
+	assert(jive::contains<malloc_op>(f->subregion(), true));
+}
+
+static inline void
+test_limit()
+{
+	using namespace jlm;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto f = create_lambda(*rm.graph(), 4096, false);
+
+	jlm::heap2stack heap2stack(1024);
+	heap2stack.run(rm, sd);
+
+	assert(jive::contains<malloc_op>(f->subregion(), true));
+}
+
+static int
+verify()
+{
+	test_promotion();
+	test_escape();
+	test_limit();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-heap2stack", verify)
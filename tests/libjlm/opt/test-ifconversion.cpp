@@ -0,0 +1,137 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/types/bitstring/arithmetic.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/ifconversion.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static inline void
+test_value()
+{
+	using namespace jlm;
+
+	valuetype vt;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({jive::bit1, "c"});
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto predicate = jive::match(1, {{1, 0}}, 1, 2, c);
+	auto gamma = jive::gamma_node::create(predicate, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evy = gamma->add_entryvar(y);
+	auto t0 = create_testop(gamma->subregion(0), {evx->argument(0)}, {&vt})[0];
+	auto t1 = create_testop(gamma->subregion(1), {evy->argument(1)}, {&vt})[0];
+	auto xv1 = gamma->add_exitvar({t0, t1});
+	auto xv2 = gamma->add_exitvar({evx->argument(0), evx->argument(1)});
+
+	auto ex1 = graph.add_export(xv1, {vt, "x1"});
+	auto ex2 = graph.add_export(xv2, {vt, "x2"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ifconversion ifconversion(8);
+	ifconversion.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(!jive::contains<jive::gamma_op>(graph.root(), true));
+
+	auto select = jive::node_output::node(ex1->origin());
+	assert(is<select_op>(select));
+	assert(select->input(0)->origin() == c);
+	assert(jive::node_output::node(select->input(1)->origin())->input(0)->origin() == x);
+	assert(ex2->origin() == x);
+}
+
+static inline void
+test_state()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	statetype st;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({jive::bit1, "c"});
+	auto s = graph.add_import({st, "s"});
+
+	auto predicate = jive::match(1, {{1, 1}}, 0, 2, c);
+	auto gamma = jive::gamma_node::create(predicate, 2);
+	auto ev = gamma->add_entryvar(s);
+	auto t0 = create_testop(gamma->subregion(0), {ev->argument(0)}, {&st})[0];
+	auto xv = gamma->add_exitvar({t0, ev->argument(1)});
+
+	graph.add_export(xv, {st, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ifconversion ifconversion(8);
+	ifconversion.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(jive::contains<jive::gamma_op>(graph.root(), true));
+}
+
+static inline void
+test_trap()
+{
+	using namespace jlm;
+
+	jive::bittype bt32(32);
+	vectortype vt(bt32, 4);
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({jive::bit1, "c"});
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto predicate = jive::match(1, {{1, 0}}, 1, 2, c);
+	auto gamma = jive::gamma_node::create(predicate, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evy = gamma->add_entryvar(y);
+
+	vectorbinary_op op(jive::bitsdiv_op(32), vt, vt, vt);
+	auto div = jive::simple_node::create_normalized(gamma->subregion(0), op,
+		{evx->argument(0), evy->argument(0)})[0];
+	auto xv = gamma->add_exitvar({div, evx->argument(1)});
+
+	graph.add_export(xv, {vt, "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ifconversion ifconversion(8);
+	ifconversion.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(jive::contains<jive::gamma_op>(graph.root(), true));
+}
+
+static int
+verify()
+{
+	test_value();
+	test_state();
+	test_trap();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-ifconversion", verify)
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/dne.hpp>
+#include <jlm/opt/memcpyexpansion.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static size_t
+nnodes(const jive::region * region, const std::type_info & type)
+{
+	size_t n = 0;
+	for (const auto & node : region->nodes) {
+		if (typeid(node.operation()) == type)
+			n++;
+	}
+
+	return n;
+}
+
+static inline void
+test_expansion()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	ptrtype pt(jive::bit8);
+	jive::fcttype ft({&pt, &pt, &mt}, {&mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto length = jive::create_bitconstant(f->subregion(), 64, 14);
+	auto isvolatile = jive::create_bitconstant(f->subregion(), 1, 0);
+	auto states = Memcpy::create(f->fctargument(0), f->fctargument(1), length, isvolatile,
+		{f->fctargument(2)});
+
+	f->finalize({states[0]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::memcpyexpansion memcpyexpansion(64);
+	memcpyexpansion.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	/*
+		14 bytes are copied in chunks of 8, 4, and 2 bytes.
+	*/
+	assert(!jive::contains<Memcpy>(f->subregion(), true));
+	assert(nnodes(f->subregion(), typeid(load_op)) == 3);
+	assert(nnodes(f->subregion(), typeid(store_op)) == 3);
+}
+
+static inline void
+test_dead_destination()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	ptrtype pt(jive::bit8);
+	jive::fcttype ft({&pt, &mt}, {&mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto one = jive::create_bitconstant(f->subregion(), 32, 1);
+	auto alloca = alloca_op::create(arraytype(jive::bit8, 256), one, 8);
+	auto mux = memstatemux_op::create_merge({alloca[1], f->fctargument(1)});
+	auto address = bitcast_op::create(alloca[0], pt);
+
+	auto length = jive::create_bitconstant(f->subregion(), 64, 256);
+	auto isvolatile = jive::create_bitconstant(f->subregion(), 1, 0);
+	auto states = Memcpy::create(address, f->fctargument(0), length, isvolatile, {mux});
+
+	f->finalize({states[0]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+	jlm::memcpyexpansion memcpyexpansion(64);
+	memcpyexpansion.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+
+	assert(!jive::contains<Memcpy>(f->subregion(), true));
+}
+
+static inline void
+test_temporary()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	ptrtype pt(jive::bit8);
+	jive::fcttype ft({&pt, &pt, &mt}, {&mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto one = jive::create_bitconstant(f->subregion(), 32, 1);
+	auto alloca = alloca_op::create(arraytype(jive::bit8, 12), one, 8);
+	auto mux = memstatemux_op::create_merge({alloca[1], f->fctargument(2)});
+	auto tmp = bitcast_op::create(alloca[0], pt);
+
+	/* the source is copied to the destination through the temporary */
+	auto length = jive::create_bitconstant(f->subregion(), 64, 12);
+	auto isvolatile = jive::create_bitconstant(f->subregion(), 1, 0);
+	auto s1 = Memcpy::create(tmp, f->fctargument(1), length, isvolatile, {mux});
+	auto s2 = Memcpy::create(f->fctargument(0), tmp, length, isvolatile, s1);
+
+	f->finalize({s2[0]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::memcpyexpansion memcpyexpansion(64);
+	memcpyexpansion.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	/*
+		The loads of the temporary are replaced by the loaded source values, and the stores to
+		the temporary are removed.
+	*/
+	assert(!jive::contains<Memcpy>(f->subregion(), true));
+	assert(nnodes(f->subregion(), typeid(load_op)) == 2);
+	assert(nnodes(f->subregion(), typeid(store_op)) == 2);
+	for (const auto & node : f->subregion()->nodes) {
+		if (!is<load_op>(&node))
+			continue;
+
+		auto address = node.input(0)->origin();
+		while (jive::node_output::node(address))
+			address = jive::node_output::node(address)->input(0)->origin();
+		assert(address == f->fctargument(1));
+	}
+}
+
+static int
+verify()
+{
+	test_expansion();
+	test_dead_destination();
+	test_temporary();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-memcpyexpansion", verify)
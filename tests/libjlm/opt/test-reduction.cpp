@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/reduction.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static inline void
+test_incremental()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ptrtype pt(vt);
+	jive::memtype mt;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto a = graph.add_import({pt, "a"});
+	auto s1 = graph.add_import({mt, "s1"});
+	auto s2 = graph.add_import({mt, "s2"});
+
+	auto l1 = load_op::create(a, {s1, s1}, 4)[0];
+	auto x1 = graph.add_export(l1, {l1->type(), "l1"});
+
+	/* the first reduction of a graph considers all nodes */
+//	jive::view(graph.root(), stdout);
+	jlm::nodereduction nodereduction;
+	nodereduction.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(jive::node_output::node(x1->origin())->ninputs() == 2);
+
+	/* nodes created and operands changed after the first reduction are reduced */
+	auto nf = load_op::normal_form(&graph);
+	nf->set_mutable(false);
+	auto l2 = load_op::create(a, {s2, s2}, 4)[0];
+	auto l3 = load_op::create(a, {s1, s2}, 4)[0];
+	auto x2 = graph.add_export(l2, {l2->type(), "l2"});
+	auto x3 = graph.add_export(l3, {l3->type(), "l3"});
+	jive::node_output::node(l3)->input(2)->divert_to(s1);
+	nf->set_mutable(true);
+
+//	jive::view(graph.root(), stdout);
+	nodereduction.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(jive::node_output::node(x2->origin())->ninputs() == 2);
+	assert(jive::node_output::node(x3->origin())->ninputs() == 2);
+}
+
+static inline void
+test_sweep()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ptrtype pt(vt);
+	jive::memtype mt;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto a = graph.add_import({pt, "a"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto l = load_op::create(a, {s, s, s}, 4)[0];
+	auto x = graph.add_export(l, {l->type(), "l"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::nodereduction nodereduction(true);
+	nodereduction.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(jive::node_output::node(x->origin())->ninputs() == 2);
+}
+
+static int
+verify()
+{
+	test_incremental();
+	test_sweep();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-reduction", verify)
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/sccp.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static inline void
+test_lambda_argument()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft1({&jive::bit32, &vt}, {&vt});
+	jive::fcttype ft2({&vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	/* f */
+	auto f = lambda::node::create(graph.root(), ft1, "f", linkage::internal_linkage);
+
+	auto match = jive::match(32, {{1, 1}}, 0, 2, f->fctargument(0));
+	auto gamma = jive::gamma_node::create(match, 2);
+	auto ev = gamma->add_entryvar(f->fctargument(1));
+	auto t0 = create_testop(gamma->subregion(0), {ev->argument(0)}, {&vt})[0];
+	auto t1 = create_testop(gamma->subregion(1), {ev->argument(1)}, {&vt})[0];
+	auto xv = gamma->add_exitvar({t0, t1});
+
+	f->finalize({xv});
+
+	/* g */
+	auto g = lambda::node::create(graph.root(), ft2, "g", linkage::external_linkage);
+	auto cv = g->add_ctxvar(f->output());
+
+	auto one = jive::create_bitconstant(g->subregion(), 32, 1);
+	auto call = call_op::create(cv, {one, g->fctargument(0)});
+
+	g->finalize({call[0]});
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sccp sccp;
+	sccp.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(!jive::contains<jive::gamma_op>(graph.root(), true));
+}
+
+static inline void
+test_theta_invariant()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({ct, "c"});
+	auto x = graph.add_import({vt, "x"});
+	auto three = jive::create_bitconstant(graph.root(), 32, 3);
+
+	auto theta = jive::theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvx = theta->add_loopvar(x);
+	auto lvf = theta->add_loopvar(three);
+
+	auto match = jive::match(32, {{3, 0}}, 1, 2, lvf->argument());
+	auto gamma = jive::gamma_node::create(match, 2);
+	auto ev = gamma->add_entryvar(lvx->argument());
+	auto t0 = create_testop(gamma->subregion(0), {ev->argument(0)}, {&vt})[0];
+	auto t1 = create_testop(gamma->subregion(1), {ev->argument(1)}, {&vt})[0];
+	auto xv = gamma->add_exitvar({t0, t1});
+
+	lvx->result()->divert_to(xv);
+	theta->set_predicate(lvc->argument());
+
+	graph.add_export(lvx, {lvx->type(), "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sccp sccp;
+	sccp.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(!jive::contains<jive::gamma_op>(graph.root(), true));
+}
+
+static inline void
+test_merged_call()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+	jive::fcttype ft1({&jive::bit32, &vt}, {&vt});
+	jive::fcttype ft2({&vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({ct, "c"});
+
+	/* f */
+	auto f = lambda::node::create(graph.root(), ft1, "f", linkage::internal_linkage);
+
+	auto match = jive::match(32, {{1, 1}}, 0, 2, f->fctargument(0));
+	auto gamma = jive::gamma_node::create(match, 2);
+	auto ev = gamma->add_entryvar(f->fctargument(1));
+	auto t0 = create_testop(gamma->subregion(0), {ev->argument(0)}, {&vt})[0];
+	auto t1 = create_testop(gamma->subregion(1), {ev->argument(1)}, {&vt})[0];
+	auto xv = gamma->add_exitvar({t0, t1});
+
+	f->finalize({xv});
+
+	/* h */
+	auto h = lambda::node::create(graph.root(), ft1, "h", linkage::internal_linkage);
+	h->finalize({h->fctargument(1)});
+
+	/*
+		g calls f directly with the constant 1, and either f or h with the constant 2. The second
+		call does not resolve to f, but still passes 2 to it.
+	*/
+	auto g = lambda::node::create(graph.root(), ft2, "g", linkage::external_linkage);
+	auto cvc = g->add_ctxvar(c);
+	auto cvf = g->add_ctxvar(f->output());
+	auto cvh = g->add_ctxvar(h->output());
+
+	auto one = jive::create_bitconstant(g->subregion(), 32, 1);
+	auto two = jive::create_bitconstant(g->subregion(), 32, 2);
+	auto call1 = call_op::create(cvf, {one, g->fctargument(0)});
+
+	auto select = jive::gamma_node::create(cvc, 2);
+	auto evf = select->add_entryvar(cvf);
+	auto evh = select->add_entryvar(cvh);
+	auto fct = select->add_exitvar({evf->argument(0), evh->argument(1)});
+	auto call2 = call_op::create(fct, {two, call1[0]});
+
+	g->finalize({call2[0]});
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sccp sccp;
+	sccp.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	/* the first argument of f is not constant */
+	assert(jive::contains<jive::gamma_op>(f->subregion(), false));
+}
+
+static int
+verify()
+{
+	test_lambda_argument();
+	test_theta_invariant();
+	test_merged_call();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-sccp", verify)
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/types/bitstring/constant.hpp>
+#include <jive/rvsdg/phi.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/specialization.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static inline void
+test()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft1({&jive::bit32, &vt}, {&vt});
+	jive::fcttype ft2({&vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	/* an unrelated lambda that occupies the first specialization name of f */
+	auto h = lambda::node::create(graph.root(), ft2, "f.spec0", linkage::internal_linkage);
+	h->finalize({h->fctargument(0)});
+
+	/* f */
+	auto f = lambda::node::create(graph.root(), ft1, "f", linkage::internal_linkage);
+	auto t = create_testop(f->subregion(), {f->fctargument(0), f->fctargument(1)}, {&vt})[0];
+	f->finalize({t});
+
+	/* g calls f twice with the constant 1 and once with the constant 2 */
+	auto g = lambda::node::create(graph.root(), ft2, "g", linkage::external_linkage);
+	auto cv = g->add_ctxvar(f->output());
+
+	auto one = jive::create_bitconstant(g->subregion(), 32, 1);
+	auto two = jive::create_bitconstant(g->subregion(), 32, 2);
+	auto call1 = call_op::create(cv, {one, g->fctargument(0)});
+	auto call2 = call_op::create(cv, {one, call1[0]});
+	auto call3 = call_op::create(cv, {two, call2[0]});
+
+	g->finalize({call3[0]});
+	graph.add_export(g->output(), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::fctspecialization fctspecialization(1000);
+	fctspecialization.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto node1 = jive::node_output::node(call1[0]);
+	auto node2 = jive::node_output::node(call2[0]);
+	auto node3 = jive::node_output::node(call3[0]);
+	auto f1 = is_direct_call(*static_cast<jive::simple_node*>(node1));
+	auto f2 = is_direct_call(*static_cast<jive::simple_node*>(node2));
+	auto f3 = is_direct_call(*static_cast<jive::simple_node*>(node3));
+
+	/* the constant 2 is only passed once */
+	assert(f1 != f && f1 == f2);
+	assert(f3 == f);
+	assert(f1->name() == "f.spec1");
+	assert(f1->fctargument(0)->nusers() == 0);
+}
+
+static inline void
+test_phi()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft1({&jive::bit32, &vt}, {&vt});
+	jive::fcttype ft2({&vt}, {&vt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	jive::phi::builder pb;
+	pb.begin(graph.root());
+	auto rvf = pb.add_recvar(ptrtype(ft1));
+	auto rvg = pb.add_recvar(ptrtype(ft2));
+
+	/* f */
+	auto f = lambda::node::create(pb.subregion(), ft1, "f", linkage::internal_linkage);
+	auto t = create_testop(f->subregion(), {f->fctargument(0), f->fctargument(1)}, {&vt})[0];
+	rvf->set_rvorigin(f->finalize({t}));
+
+	/* g calls f twice with the constant 1 */
+	auto g = lambda::node::create(pb.subregion(), ft2, "g", linkage::external_linkage);
+	auto cv = g->add_ctxvar(rvf->argument());
+
+	auto one = jive::create_bitconstant(g->subregion(), 32, 1);
+	auto call1 = call_op::create(cv, {one, g->fctargument(0)});
+	auto call2 = call_op::create(cv, {one, call1[0]});
+	rvg->set_rvorigin(g->finalize({call2[0]}));
+
+	auto phi = pb.end();
+	graph.add_export(phi->output(1), {ptrtype(g->type()), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::fctspecialization fctspecialization(1000);
+	fctspecialization.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto f1 = is_direct_call(*static_cast<jive::simple_node*>(jive::node_output::node(call1[0])));
+	auto f2 = is_direct_call(*static_cast<jive::simple_node*>(jive::node_output::node(call2[0])));
+
+	/* a specialized lambda would need its own recursion variable */
+	assert(f1 == f && f2 == f);
+}
+
+static int
+verify()
+{
+	test();
+	test_phi();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-specialization", verify)
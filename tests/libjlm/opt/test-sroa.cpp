@@ -0,0 +1,210 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/theta.hpp>
+#include <jive/types/bitstring/constant.hpp>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/dne.hpp>
+#include <jlm/opt/sroa.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static inline void
+test_aggregate()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	arraytype at(jive::bit32, 2);
+	ptrtype pt(jive::bit32);
+	jive::fcttype ft({&jive::bit32, &jive::bit32, &mt}, {&jive::bit32, &mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+	auto x = f->fctargument(0);
+	auto y = f->fctargument(1);
+
+	auto zero = jive::create_bitconstant(f->subregion(), 32, 0);
+	auto one = jive::create_bitconstant(f->subregion(), 32, 1);
+	auto alloca = alloca_op::create(at, one, 4);
+	auto mux = memstatemux_op::create_merge({alloca[1], f->fctargument(2)});
+
+	auto gep0 = getelementptr_op::create(alloca[0], {zero, zero}, pt);
+	auto gep1 = getelementptr_op::create(alloca[0], {zero, one}, pt);
+	auto s0 = store_op::create(gep0, x, {mux}, 4);
+	auto s1 = store_op::create(gep1, y, s0, 4);
+	auto ld = load_op::create(gep0, s1, 4);
+
+	f->finalize({ld[0], ld[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sroa sroa;
+	sroa.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(f->fctresult(0)->origin() == x);
+	assert(!jive::contains<jlm::alloca_op>(f->subregion(), true));
+	assert(!jive::contains<jlm::load_op>(f->subregion(), true));
+}
+
+static inline void
+test_theta()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	jive::ctltype ct(2);
+	ptrtype pt(jive::bit32);
+	jive::fcttype ft({&jive::bit32, &ct, &mt}, {&jive::bit32, &mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto one = jive::create_bitconstant(f->subregion(), 32, 1);
+	auto alloca = alloca_op::create(jive::bit32, one, 4);
+	auto mux = memstatemux_op::create_merge({alloca[1], f->fctargument(2)});
+	auto s0 = store_op::create(alloca[0], f->fctargument(0), {mux}, 4);
+
+	auto theta = jive::theta_node::create(f->subregion());
+	auto lva = theta->add_loopvar(alloca[0]);
+	auto lvc = theta->add_loopvar(f->fctargument(1));
+	auto lvs = theta->add_loopvar(s0[0]);
+
+	auto ld = load_op::create(lva->argument(), {lvs->argument()}, 4);
+	auto t = jlm::create_testop(theta->subregion(), {ld[0]}, {&jive::bit32})[0];
+	auto s1 = store_op::create(lva->argument(), t, {ld[1]}, 4);
+	lvs->result()->divert_to(s1[0]);
+	theta->set_predicate(lvc->argument());
+
+	auto ld2 = load_op::create(alloca[0], {lvs}, 4);
+
+	f->finalize({ld2[0], ld2[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sroa sroa;
+	sroa.run(rm, sd);
+	jlm::dne dne;
+	dne.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(!jive::contains<jlm::alloca_op>(f->subregion(), true));
+	assert(!jive::contains<jlm::load_op>(f->subregion(), true));
+	assert(!jive::contains<jlm::store_op>(f->subregion(), true));
+}
+
+static inline void
+test_decay()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	arraytype at(jive::bit32, 2);
+	ptrtype pt(jive::bit32);
+	jive::fcttype ft({&jive::bit32, &mt}, {&jive::bit32, &mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto zero = jive::create_bitconstant(f->subregion(), 32, 0);
+	auto one = jive::create_bitconstant(f->subregion(), 32, 1);
+	auto alloca = alloca_op::create(at, one, 4);
+	auto mux = memstatemux_op::create_merge({alloca[1], f->fctargument(1)});
+
+	/* the decayed address of the first element indexes the second element */
+	auto gep0 = getelementptr_op::create(alloca[0], {zero, zero}, pt);
+	auto gep1 = getelementptr_op::create(alloca[0], {zero, one}, pt);
+	auto decayed = getelementptr_op::create(gep0, {one}, pt);
+	auto s0 = store_op::create(decayed, f->fctargument(0), {mux}, 4);
+	auto ld = load_op::create(gep1, s0, 4);
+
+	f->finalize({ld[0], ld[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sroa sroa;
+	sroa.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(f->fctresult(0)->origin() == ld[0]);
+	assert(jive::node_output::node(ld[0])->input(0)->origin() == gep1);
+	assert(jive::node_output::node(gep1)->input(0)->origin() == alloca[0]);
+}
+
+static inline void
+test_infeasible()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	jive::ctltype ct(2);
+	jive::fcttype ft({&jive::bit32, &ct, &mt}, {&jive::bit32, &jive::bit32, &mt});
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto f = lambda::node::create(graph.root(), ft, "f", linkage::external_linkage);
+
+	auto one = jive::create_bitconstant(f->subregion(), 32, 1);
+	auto alloca = alloca_op::create(jive::bit32, one, 4);
+	auto mux = memstatemux_op::create_merge({alloca[1], f->fctargument(2)});
+	auto s0 = store_op::create(alloca[0], f->fctargument(0), {mux}, 4);
+
+	auto gamma = jive::gamma_node::create(f->fctargument(1), 2);
+	auto eva = gamma->add_entryvar(alloca[0]);
+	auto evs = gamma->add_entryvar(s0[0]);
+	auto ld0 = load_op::create(eva->argument(0), {evs->argument(0)}, 4);
+	auto xv = gamma->add_exitvar({ld0[0], one});
+	auto xs = gamma->add_exitvar({ld0[1], evs->argument(1)});
+
+	/* the value of the alloca is unknown after an operation with two memory states */
+	auto state = jlm::create_testop(f->subregion(), {xs, f->fctargument(2)}, {&mt})[0];
+	auto ld1 = load_op::create(alloca[0], {state}, 4);
+
+	f->finalize({xv, ld1[0], ld1[1]});
+	graph.add_export(f->output(), {ptrtype(f->type()), "f"});
+
+	auto ninputs = gamma->ninputs();
+
+//	jive::view(graph.root(), stdout);
+	jlm::sroa sroa;
+	sroa.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(gamma->ninputs() == ninputs);
+	assert(gamma->subregion(0)->result(0)->origin() == ld0[0]);
+	assert(f->fctresult(1)->origin() == ld1[0]);
+}
+
+static int
+verify()
+{
+	test_aggregate();
+	test_theta();
+	test_decay();
+	test_infeasible();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-sroa", verify)
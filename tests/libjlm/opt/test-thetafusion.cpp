@@ -0,0 +1,128 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.hpp>
+#include <jive/types/bitstring/constant.hpp>
+#include <jive/types/bitstring/comparison.hpp>
+#include <jive/view.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/theta.hpp>
+
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/thetafusion.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static size_t
+nthetas(jive::region * region)
+{
+	size_t n = 0;
+	for (const auto & node : region->nodes) {
+		if (jive::is<jive::theta_op>(&node))
+			n++;
+	}
+
+	return n;
+}
+
+static jive::theta_node *
+create_theta(jive::output * x, jive::output * end)
+{
+	using namespace jive;
+
+	jlm::valuetype vt;
+	auto graph = x->region()->graph();
+
+	auto init = create_bitconstant(graph->root(), 32, 0);
+	auto step = create_bitconstant(graph->root(), 32, 1);
+
+	auto theta = theta_node::create(graph->root());
+	auto subregion = theta->subregion();
+	auto idv = theta->add_loopvar(init);
+	auto lvs = theta->add_loopvar(step);
+	auto lve = theta->add_loopvar(end);
+	auto lvx = theta->add_loopvar(x);
+
+	auto arm = bitadd_op::create(32, idv->argument(), lvs->argument());
+	auto cmp = bitult_op::create(32, arm, lve->argument());
+	auto match = jive::match(1, {{1, 1}}, 0, 2, cmp);
+	auto t = jlm::create_testop(subregion, {lvx->argument()}, {&vt})[0];
+
+	idv->result()->divert_to(arm);
+	lvx->result()->divert_to(t);
+	theta->set_predicate(match);
+
+	return theta;
+}
+
+static inline void
+test_fusion()
+{
+	using namespace jlm;
+
+	valuetype vt;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto n = graph.add_import({jive::bit32, "n"});
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto theta1 = create_theta(x, n);
+	auto theta2 = create_theta(y, n);
+
+	graph.add_export(theta1->output(3), {vt, "x"});
+	graph.add_export(theta2->output(3), {vt, "y"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::thetafusion thetafusion;
+	thetafusion.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	assert(nthetas(graph.root()) == 1);
+	assert(jive::node_output::node(graph.root()->result(0)->origin())
+		== jive::node_output::node(graph.root()->result(1)->origin()));
+}
+
+static inline void
+test_dependency()
+{
+	using namespace jlm;
+
+	valuetype vt;
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto n = graph.add_import({jive::bit32, "n"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto theta1 = create_theta(x, n);
+	auto theta2 = create_theta(theta1->output(3), n);
+
+	graph.add_export(theta2->output(3), {vt, "x"});
+
+	jlm::thetafusion thetafusion;
+	thetafusion.run(rm, sd);
+
+	assert(nthetas(graph.root()) == 2);
+}
+
+static int
+verify()
+{
+	test_fusion();
+	test_dependency();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-thetafusion", verify)
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.hpp>
+#include <jive/rvsdg/control.hpp>
+#include <jive/rvsdg/gamma.hpp>
+#include <jive/rvsdg/theta.hpp>
+
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/unswitching.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static inline void
+test_unswitching()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({ct, "c"});
+	auto p = graph.add_import({ct, "p"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto theta = jive::theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvp = theta->add_loopvar(p);
+	auto lvx = theta->add_loopvar(x);
+
+	auto gamma = jive::gamma_node::create(lvc->argument(), 2);
+	auto ev = gamma->add_entryvar(lvx->argument());
+	auto t0 = create_testop(gamma->subregion(0), {ev->argument(0)}, {&vt})[0];
+	auto t1 = create_testop(gamma->subregion(1), {ev->argument(1)}, {&vt})[0];
+	auto xv = gamma->add_exitvar({t0, t1});
+
+	lvx->result()->divert_to(xv);
+	theta->set_predicate(lvp->argument());
+
+	graph.add_export(lvx, {vt, "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::loopunswitching loopunswitching(100);
+	loopunswitching.run(rm, sd);
+//	jive::view(graph.root(), stdout);
+
+	auto node = jive::node_output::node(graph.root()->result(0)->origin());
+	assert(jive::is<jive::gamma_op>(node));
+
+	auto ngamma = static_cast<jive::gamma_node*>(node);
+	assert(ngamma->predicate()->origin() == c);
+	for (size_t n = 0; n < ngamma->nsubregions(); n++) {
+		auto subregion = ngamma->subregion(n);
+		assert(subregion->nnodes() == 1);
+
+		for (auto & ntheta : subregion->nodes) {
+			assert(jive::is<jive::theta_op>(&ntheta));
+			assert(!jive::contains<jive::gamma_op>(static_cast<jive::theta_node*>(&ntheta)->subregion(), true));
+		}
+	}
+}
+
+static inline void
+test_budget()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+
+	rvsdg_module rm(filepath(""), "", "");
+	auto & graph = *rm.graph();
+
+	auto c = graph.add_import({ct, "c"});
+	auto p = graph.add_import({ct, "p"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto theta = jive::theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvp = theta->add_loopvar(p);
+	auto lvx = theta->add_loopvar(x);
+
+	auto gamma = jive::gamma_node::create(lvc->argument(), 2);
+	auto ev = gamma->add_entryvar(lvx->argument());
+	auto t0 = create_testop(gamma->subregion(0), {ev->argument(0)}, {&vt})[0];
+	auto xv = gamma->add_exitvar({t0, ev->argument(1)});
+
+	lvx->result()->divert_to(xv);
+	theta->set_predicate(lvp->argument());
+
+	graph.add_export(lvx, {vt, "x"});
+
+	jlm::loopunswitching loopunswitching(0);
+	loopunswitching.run(rm, sd);
+
+	assert(jive::node_output::node(graph.root()->result(0)->origin()) == theta);
+}
+
+static int
+verify()
+{
+	test_unswitching();
+	test_budget();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-unswitching", verify)
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/common.hpp>
+#include <jlm/util/parallel.hpp>
+
+#include <assert.h>
+
+static inline void
+test_for()
+{
+	const size_t n = 1000;
+
+	std::vector<std::atomic<size_t>> invocations(n);
+	for (auto & invocation : invocations)
+		invocation = 0;
+
+	jlm::parallel_for(n, [&](size_t i){ invocations[i]++; });
+
+	/* every index is invoked exactly once */
+	for (const auto & invocation : invocations)
+		assert(invocation == 1);
+}
+
+static inline void
+test_for_exception()
+{
+	bool thrown = false;
+	try {
+		jlm::parallel_for(1000, [](size_t i)
+		{
+			if (i == 500)
+				throw jlm::error("parallel_for");
+		});
+	} catch (const jlm::error & e) {
+		thrown = std::string(e.what()) == "parallel_for";
+	}
+
+	assert(thrown);
+}
+
+static inline void
+test_pipeline()
+{
+	const size_t n = 1000;
+
+	std::vector<std::atomic<bool>> produced(n);
+	for (auto & p : produced)
+		p = false;
+
+	std::vector<size_t> consumed;
+	jlm::parallel_pipeline(n,
+		[&](size_t i){ produced[i] = true; },
+		[&](size_t i)
+		{
+			/* a consumption happens after the production of its index */
+			assert(produced[i]);
+			consumed.push_back(i);
+		});
+
+	/* the consumptions happen in index order */
+	assert(consumed.size() == n);
+	for (size_t i = 0; i < n; i++)
+		assert(consumed[i] == i);
+}
+
+static inline void
+test_pipeline_exception()
+{
+	bool thrown = false;
+	try {
+		jlm::parallel_pipeline(1000,
+			[](size_t i)
+			{
+				if (i == 500)
+					throw jlm::error("produce");
+			},
+			[](size_t){});
+	} catch (const jlm::error & e) {
+		thrown = std::string(e.what()) == "produce";
+	}
+	assert(thrown);
+
+	thrown = false;
+	try {
+		jlm::parallel_pipeline(1000,
+			[](size_t){},
+			[](size_t i)
+			{
+				if (i == 500)
+					throw jlm::error("consume");
+			});
+	} catch (const jlm::error & e) {
+		thrown = std::string(e.what()) == "consume";
+	}
+	assert(thrown);
+}
+
+static int
+test()
+{
+	test_for();
+	test_for_exception();
+	test_pipeline();
+	test_pipeline_exception();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-parallel", test)